@@ -1,6 +1,12 @@
 #ifndef REIO_ALLOCATORS_HPP
 #define REIO_ALLOCATORS_HPP
 
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <cstddef>
+
+#endif
+
 #include "./asserts.hpp"
 #include "./types.hpp"
 
@@ -8,29 +14,51 @@
 namespace reio
 {
 
+    /// @brief Alignment which allocations get unless asked for more, enough for any scalar type.
+    static constexpr std::size_t k_default_alignment = alignof(std::max_align_t);
+
+
     ///
     /// @brief      Base for allocator classes used by @c reio.
     ///
+    /// @c deallocate receives the same size and alignment which were passed to @c allocate,
+    /// so implementations don't need to keep per-allocation headers. @n
+    ///
+    /// Alignments are powers of two; anything up to @c k_default_alignment is always satisfied,
+    /// so passing a smaller one is the same as passing the default. @n
+    ///
+    /// Resizing goes through @c try_expand and @c reallocate, which by default
+    /// never resize in place, and fall back to allocate-copy-deallocate.
+    /// Either way, the block keeps the alignment it was allocated with.
+    ///
     class base_allocator
     {
     public:
         virtual ~base_allocator() = default;
-        virtual byte* allocate(std::size_t size) = 0;
-        virtual void deallocate(byte* ptr) = 0;
+        virtual byte* allocate(std::size_t size, std::size_t alignment = k_default_alignment) = 0;
+        virtual void deallocate(byte* ptr, std::size_t size, std::size_t alignment = k_default_alignment) = 0;
+        virtual bool try_expand(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment = k_default_alignment);
+        virtual byte* reallocate(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t preserved,
+                                 std::size_t alignment = k_default_alignment);
     };
 
 
     ///
     /// @brief      The most basic @c base_allocator implementation
-    ///             which just wraps global new and delete operators.
+    ///             which just wraps global malloc, realloc and free.
+    ///
+    /// Over-aligned blocks come from aligned @c operator @c new instead,
+    /// and are reallocated by copying, since @c realloc wouldn't keep their alignment.
     ///
     class default_allocator final
         : public base_allocator
     {
     public:
 
-        byte* allocate(std::size_t size) override;
-        void deallocate(byte* ptr) override;
+        byte* allocate(std::size_t size, std::size_t alignment = k_default_alignment) override;
+        void deallocate(byte* ptr, std::size_t size, std::size_t alignment = k_default_alignment) override;
+        byte* reallocate(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t preserved,
+                         std::size_t alignment = k_default_alignment) override;
 
         static inline default_allocator* get_default() noexcept
         {
@@ -39,6 +67,184 @@ namespace reio
         }
     };
 
+
+    static constexpr std::size_t k_default_block_alignment = 4096u;
+
+
+    ///
+    /// @brief      Allocator which returns blocks aligned to a fixed power of two.
+    ///
+    /// Meant for buffers which are passed to the kernel with @c O_DIRECT, or loaded
+    /// with aligned SIMD instructions. The default alignment matches the logical block
+    /// size of most devices and the page size of most platforms. @n
+    ///
+    /// Thread-safe.
+    ///
+    class aligned_allocator final
+        : public base_allocator
+    {
+    private:
+
+        std::size_t     m_alignment;
+
+    public:
+
+        explicit aligned_allocator(std::size_t alignment = k_default_block_alignment);
+
+        byte* allocate(std::size_t size, std::size_t alignment = k_default_alignment) override;
+        void deallocate(byte* ptr, std::size_t size, std::size_t alignment = k_default_alignment) override;
+
+        [[nodiscard]] std::size_t alignment() const noexcept;
+
+        static inline aligned_allocator* get_default() noexcept
+        {
+            static aligned_allocator instance;
+            return &instance;
+        }
+    };
+
+
+    static constexpr std::size_t k_default_arena_chunk_size = 64u * 1024u;
+
+
+    ///
+    /// @brief      Memory usage counters of an @c arena_allocator.
+    ///
+    struct arena_stats final
+    {
+        std::size_t m_chunk_count = 0u;             //< Number of chunks currently held.
+        std::size_t m_bytes_reserved = 0u;          //< Total usable size of all held chunks.
+        std::size_t m_bytes_allocated = 0u;         //< Bytes handed out since the last reset (incl. padding).
+        std::size_t m_allocation_count = 0u;        //< Allocations made since the last reset.
+    };
+
+
+    ///
+    /// @brief      Bump-pointer allocator which frees all of its allocations at once.
+    ///
+    /// Allocations are carved out of large chunks requested from an upstream allocator,
+    /// so creating many short-lived buffers costs a pointer increment each. @n
+    ///
+    /// @c deallocate only reclaims memory of the most recent allocation (e.g. a buffer
+    /// which was just reallocated), everything else stays in use until @c reset
+    /// or destruction. Likewise, the most recent allocation can be resized in place
+    /// while it fits into its chunk. Requests bigger than the chunk size get a dedicated chunk.
+    /// Over-aligned requests pad the cursor up to their alignment. @n
+    ///
+    /// All buffers using the arena must be destroyed before it's reset or destroyed.
+    /// Not thread-safe.
+    ///
+    class arena_allocator final
+        : public base_allocator
+        , public non_copyable
+    {
+    private:
+
+        struct chunk_header;
+
+        base_allocator*         m_upstream;
+        std::size_t             m_chunk_size;
+        chunk_header*           m_chunks;
+        byte*                   m_cursor;
+        byte*                   m_chunk_end;
+        byte*                   m_last;
+        byte*                   m_last_cursor;         //< Cursor before the most recent allocation, incl. its padding.
+        arena_stats             m_stats;
+
+    public:
+
+        explicit arena_allocator(std::size_t chunk_size = k_default_arena_chunk_size,
+                                 base_allocator* upstream = default_allocator::get_default());
+        ~arena_allocator() noexcept override;
+
+        byte* allocate(std::size_t size, std::size_t alignment = k_default_alignment) override;
+        void deallocate(byte* ptr, std::size_t size, std::size_t alignment = k_default_alignment) override;
+        bool try_expand(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment = k_default_alignment) override;
+
+        void reset() noexcept;
+        void release() noexcept;
+
+        [[nodiscard]] std::size_t chunk_size() const noexcept;
+        [[nodiscard]] arena_stats stats() const noexcept;
+
+    private:
+
+        chunk_header* add_chunk(std::size_t size);
+
+    };
+
+
+    static constexpr std::size_t k_pool_min_block_size = 16u;
+    static constexpr std::size_t k_default_pool_max_block_size = 256u;
+    static constexpr std::size_t k_default_pool_slab_size = 16u * 1024u;
+
+
+    ///
+    /// @brief      Memory usage counters of a @c pool_allocator.
+    ///
+    struct pool_stats final
+    {
+        std::size_t m_slab_count = 0u;              //< Number of slabs currently held.
+        std::size_t m_bytes_reserved = 0u;          //< Total usable size of all held slabs.
+        std::size_t m_blocks_in_use = 0u;           //< Pooled blocks which weren't deallocated yet.
+        std::size_t m_upstream_allocations = 0u;    //< Live allocations too big for the pool.
+    };
+
+
+    ///
+    /// @brief      Allocator which recycles small blocks through per-size free lists.
+    ///
+    /// Requests are rounded up to power-of-two size classes, from @c k_pool_min_block_size
+    /// to a configurable maximum. Each class carves its blocks out of slabs taken from
+    /// an upstream allocator, and keeps deallocated blocks in a free list, so both
+    /// @c allocate and @c deallocate are O(1). Bigger and over-aligned requests are passed upstream as is. @n
+    ///
+    /// Slabs are only returned upstream on destruction, so all buffers using the pool
+    /// must be destroyed before it. Not thread-safe.
+    ///
+    class pool_allocator final
+        : public base_allocator
+        , public non_copyable
+    {
+    private:
+
+        struct slab_header;
+        struct free_block;
+
+        static constexpr std::size_t k_max_classes = 16u;
+
+        base_allocator*         m_upstream;
+        std::size_t             m_max_block_size;
+        std::size_t             m_slab_size;
+        std::size_t             m_class_count;
+        free_block*             m_free_lists[k_max_classes];
+        slab_header*            m_slabs;
+        pool_stats              m_stats;
+
+    public:
+
+        explicit pool_allocator(std::size_t max_block_size = k_default_pool_max_block_size,
+                                std::size_t slab_size = k_default_pool_slab_size,
+                                base_allocator* upstream = default_allocator::get_default());
+        ~pool_allocator() noexcept override;
+
+        byte* allocate(std::size_t size, std::size_t alignment = k_default_alignment) override;
+        void deallocate(byte* ptr, std::size_t size, std::size_t alignment = k_default_alignment) override;
+        bool try_expand(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment = k_default_alignment) override;
+        byte* reallocate(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t preserved,
+                         std::size_t alignment = k_default_alignment) override;
+
+        [[nodiscard]] std::size_t max_block_size() const noexcept;
+        [[nodiscard]] static std::size_t block_size_for(std::size_t size) noexcept;
+        [[nodiscard]] pool_stats stats() const noexcept;
+
+    private:
+
+        [[nodiscard]] bool is_upstream(std::size_t size, std::size_t alignment) const noexcept;
+        void refill(std::size_t class_index);
+
+    };
+
 }
 
 
@@ -1,6 +1,13 @@
 #ifndef REIO_OWNING_BUFFER_HPP
 #define REIO_OWNING_BUFFER_HPP
 
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <new>
+
+#endif
+
 #include "../allocators.hpp"
 #include "../asserts.hpp"
 #include "../types.hpp"
@@ -33,6 +40,9 @@ namespace reio
     /// The go-to buffer for dynamic blob allocations that could be seen
     /// as a simpler in-codebase alternative to vector<byte>. @n
     ///
+    /// Memory is aligned to @c k_default_alignment, unless the buffer is created
+    /// with a bigger alignment, which it then keeps across reallocations. @n
+    ///
     /// @ingroup    buffers
     ///
     class owning_buffer final : public non_copyable
@@ -58,11 +68,13 @@ namespace reio
         pointer                 m_alloc_end;
         alloc_ptr               m_allocator;
         growth_factor           m_growth;
+        size_type               m_alignment;
 
     public:
 
         explicit owning_buffer(alloc_ptr alloc = default_allocator::get_default());
         explicit owning_buffer(size_type capacity, alloc_ptr alloc = default_allocator::get_default());
+        owning_buffer(size_type capacity, std::align_val_t alignment, alloc_ptr alloc = default_allocator::get_default());
         owning_buffer(size_type length, value_type value, alloc_ptr alloc = default_allocator::get_default());
         explicit owning_buffer(weak_buffer copy, alloc_ptr alloc = default_allocator::get_default());
         ~owning_buffer() noexcept;
@@ -75,6 +87,7 @@ namespace reio
         [[nodiscard]] size_type capacity() const noexcept;
         [[nodiscard]] growth_factor growth() const noexcept;
         [[nodiscard]] alloc_ptr allocator() const noexcept;
+        [[nodiscard]] size_type alignment() const noexcept;
 
         void set_growth(growth_factor factor) noexcept;
 
@@ -205,6 +218,68 @@ namespace reio
         return dest_iter + write_length;
     }
 
+    ///
+    /// @brief      Get pointer to the start of the owned bytes.
+    /// @return     Pointer to the start of the owned memory block.
+    ///
+    inline owning_buffer::pointer
+    owning_buffer::data() const noexcept
+    {
+        return m_begin;
+    }
+
+    ///
+    /// @brief      Get number of the owned bytes in use.
+    /// @return     Length (in bytes) of the used memory block.
+    ///
+    inline owning_buffer::size_type
+    owning_buffer::length() const noexcept
+    {
+        return static_cast<size_type>(m_end - m_begin);
+    }
+
+    ///
+    /// @brief      Get number of the owned bytes in total (possibly beyond what's currently used).
+    /// @return     Length (in bytes) of the owned memory block.
+    ///
+    inline owning_buffer::size_type
+    owning_buffer::capacity() const noexcept
+    {
+        return static_cast<size_type>(m_alloc_end - m_begin);
+    }
+
+    ///
+    /// @brief      Get a byte within the buffer, without bounds check.
+    /// @param      index    Index of the byte.
+    /// @return     Non-const reference to a byte at @c index.
+    ///
+    inline owning_buffer::reference
+    owning_buffer::operator[](owning_buffer::size_type index) noexcept
+    {
+        return m_begin[index];
+    }
+
+    ///
+    /// @brief      Get a byte within the buffer, without bounds check.
+    /// @param      index    Index of the byte.
+    /// @return     Copy of a byte at @c index.
+    ///
+    inline owning_buffer::value_type
+    owning_buffer::operator[](owning_buffer::size_type index) const noexcept
+    {
+        return m_begin[index];
+    }
+
+    inline owning_buffer::iterator owning_buffer::begin() noexcept { return m_begin; }
+    inline owning_buffer::iterator owning_buffer::end() noexcept { return m_end; }
+    inline owning_buffer::const_iterator owning_buffer::begin() const noexcept { return m_begin; }
+    inline owning_buffer::const_iterator owning_buffer::end() const noexcept { return m_end; }
+    inline owning_buffer::const_iterator owning_buffer::cbegin() const noexcept { return m_begin; }
+    inline owning_buffer::const_iterator owning_buffer::cend() const noexcept { return m_end; }
+    inline owning_buffer::iterator owning_buffer::alloc_end() noexcept { return m_alloc_end; }
+    inline owning_buffer::const_iterator owning_buffer::alloc_end() const noexcept { return m_alloc_end; }
+    inline owning_buffer::const_iterator owning_buffer::alloc_cend() const noexcept { return m_alloc_end; }
+
     inline bool
     owning_buffer::iter_within(std::contiguous_iterator auto iter) const noexcept
     {
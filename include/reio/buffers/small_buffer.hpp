@@ -0,0 +1,490 @@
+#ifndef REIO_SMALL_BUFFER_HPP
+#define REIO_SMALL_BUFFER_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#endif
+
+#include "../allocators.hpp"
+#include "../asserts.hpp"
+#include "../types.hpp"
+#include "../buffers/owning_buffer.hpp"
+#include "../buffers/weak_buffer.hpp"
+
+
+namespace reio
+{
+
+    ///
+    /// @brief      Dynamically-sized contiguous byte sequence
+    ///             which stores up to @c N bytes inline.
+    ///
+    /// Has the same interface as @c owning_buffer, but doesn't touch its allocator
+    /// until the contents outgrow the inline storage, which makes it a better fit
+    /// for the many tiny payloads (magic numbers, short names, GUIDs) of a typical format. @n
+    ///
+    /// Once moved to the heap, the buffer stays there. Moving an inline buffer copies
+    /// at most @c N bytes, moving a heap buffer just takes over its allocation;
+    /// either way, the moved-from buffer is left empty and inline. @n
+    ///
+    /// @tparam     N    Size (in bytes) of the inline storage.
+    ///
+    /// @ingroup    buffers
+    ///
+    template<std::size_t N>
+    class small_buffer final : public non_copyable
+    {
+        static_assert(N > 0u, "small buffer needs inline storage");
+
+    public:
+
+        using alloc_ptr         = base_allocator*;
+
+        using size_type         = std::size_t;
+        using difference_type   = std::ptrdiff_t;
+
+        using value_type        = byte;
+        using pointer           = value_type*;
+        using reference         = value_type&;
+
+        using iterator          = value_type*;
+        using const_iterator    = const value_type*;
+
+    private:
+
+        alignas(k_default_alignment) value_type     m_inline[N];
+
+        pointer                 m_begin;
+        size_type               m_length;
+        size_type               m_capacity;
+        alloc_ptr               m_allocator;
+        growth_factor           m_growth;
+
+    public:
+
+        explicit small_buffer(alloc_ptr alloc = default_allocator::get_default());
+        explicit small_buffer(size_type capacity, alloc_ptr alloc = default_allocator::get_default());
+        small_buffer(size_type length, value_type value, alloc_ptr alloc = default_allocator::get_default());
+        explicit small_buffer(weak_buffer copy, alloc_ptr alloc = default_allocator::get_default());
+        ~small_buffer() noexcept;
+
+        small_buffer(small_buffer&& other) noexcept;
+        small_buffer& operator=(small_buffer&& other) noexcept;
+
+        [[nodiscard]] pointer data() const noexcept { return m_begin; }
+        [[nodiscard]] size_type length() const noexcept { return m_length; }
+        [[nodiscard]] size_type capacity() const noexcept { return m_capacity; }
+        [[nodiscard]] growth_factor growth() const noexcept { return m_growth; }
+        [[nodiscard]] alloc_ptr allocator() const noexcept { return m_allocator; }
+        [[nodiscard]] bool is_inline() const noexcept { return m_begin == m_inline; }
+        [[nodiscard]] static constexpr size_type inline_capacity() noexcept { return N; }
+
+        void set_growth(growth_factor factor) noexcept { m_growth = factor; }
+
+        void resize_to_zero() noexcept { m_length = 0u; }
+        void resize_to_capacity() noexcept { m_length = m_capacity; }
+
+        [[nodiscard]] reference operator[](size_type index) noexcept { return m_begin[index]; }
+        [[nodiscard]] value_type operator[](size_type index) const noexcept { return m_begin[index]; }
+
+        [[nodiscard]] value_type at(size_type index) const;
+
+        [[nodiscard]] weak_buffer view() const noexcept { return { m_begin, m_length }; }
+        [[nodiscard]] weak_buffer subview(size_type offset, size_type size) const;
+
+        [[nodiscard]] weak_buffer first(size_type size) const;
+        [[nodiscard]] weak_buffer last(size_type size) const;
+        [[nodiscard]] weak_buffer last_from(size_type offset) const;
+
+        [[nodiscard]] iterator begin() noexcept { return m_begin; }
+        [[nodiscard]] iterator end() noexcept { return m_begin + m_length; }
+        [[nodiscard]] const_iterator begin() const noexcept { return m_begin; }
+        [[nodiscard]] const_iterator end() const noexcept { return m_begin + m_length; }
+        [[nodiscard]] const_iterator cbegin() const noexcept { return m_begin; }
+        [[nodiscard]] const_iterator cend() const noexcept { return m_begin + m_length; }
+        [[nodiscard]] iterator alloc_end() noexcept { return m_begin + m_capacity; }
+        [[nodiscard]] const_iterator alloc_end() const noexcept { return m_begin + m_capacity; }
+        [[nodiscard]] const_iterator alloc_cend() const noexcept { return m_begin + m_capacity; }
+
+        template<std::contiguous_iterator ContigIt>
+        iterator overwrite(ContigIt src_begin, ContigIt src_end, const_iterator dest_begin);
+
+        template<std::contiguous_iterator ContigIt>
+        iterator insert(ContigIt src_begin, ContigIt src_end, const_iterator dest_begin);
+
+        iterator erase(const_iterator first, const_iterator last);
+
+    private:
+
+        [[nodiscard]] bool iter_within(const_iterator iter) const noexcept;
+
+        [[nodiscard]] size_type next_capacity(size_type over) const;
+        void do_realloc(size_type new_capacity);
+        void take_over(small_buffer& other) noexcept;
+        void release() noexcept;
+
+    };
+
+
+    ///
+    /// @brief      Default-initialize the buffer, using the inline storage.
+    /// @param      alloc           Optional custom allocator, used once the buffer outgrows @c N bytes.
+    /// @throw      io_exception    If @c alloc is NULL.
+    ///
+    template<std::size_t N>
+    small_buffer<N>::small_buffer(alloc_ptr alloc)
+        : m_inline{}, m_begin{ m_inline }
+        , m_length{ 0u }, m_capacity{ N }
+        , m_allocator{ alloc }
+        , m_growth{ k_default_growth_factor }
+    {
+        REIO_ASSERT(alloc != nullptr, "small buffer can't have null allocator");
+    }
+
+    ///
+    /// @brief      Initialize the buffer by preallocating some memory.
+    /// @param      capacity        Amount of memory to preallocate; up to @c N bytes don't allocate anything.
+    /// @param      alloc           Optional custom allocator to use.
+    /// @throw      io_exception    If @c alloc is NULL, or preallocation fails.
+    ///
+    template<std::size_t N>
+    small_buffer<N>::small_buffer(size_type capacity, alloc_ptr alloc)
+        : small_buffer{ alloc }
+    {
+        do_realloc(capacity);
+    }
+
+    ///
+    /// @brief      Initialize the buffer with a repetition of a single value.
+    /// @param      length          Number of bytes to initialize.
+    /// @param      value           Byte value.
+    /// @param      alloc           Optional custom allocator to use.
+    /// @throw      io_exception    If @c alloc is NULL, or allocation fails.
+    ///
+    template<std::size_t N>
+    small_buffer<N>::small_buffer(size_type length, value_type value, alloc_ptr alloc)
+        : small_buffer{ length, alloc }
+    {
+        std::fill_n(m_begin, length, value);
+        m_length = length;
+    }
+
+    ///
+    /// @brief      Initialize the buffer by copying in a chunk of memory.
+    /// @param      copy            Chunk of memory to copy.
+    /// @param      alloc           Optional custom allocator to use.
+    /// @throw      io_exception    If @c alloc is NULL, or allocation fails.
+    ///
+    template<std::size_t N>
+    small_buffer<N>::small_buffer(weak_buffer copy, alloc_ptr alloc)
+        : small_buffer{ copy.length(), alloc }
+    {
+        std::copy_n(copy.data(), copy.length(), m_begin);
+        m_length = copy.length();
+    }
+
+    template<std::size_t N>
+    small_buffer<N>::~small_buffer() noexcept
+    {
+        release();
+    }
+
+    template<std::size_t N>
+    small_buffer<N>::small_buffer(small_buffer&& other) noexcept
+        : m_inline{}, m_begin{ m_inline }
+        , m_length{ 0u }, m_capacity{ N }
+        , m_allocator{ other.m_allocator }
+        , m_growth{ other.m_growth }
+    {
+        take_over(other);
+    }
+
+    template<std::size_t N>
+    small_buffer<N>&
+    small_buffer<N>::operator=(small_buffer&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+
+            m_allocator = other.m_allocator;
+            m_growth = other.m_growth;
+            take_over(other);
+        }
+        return *this;
+    }
+
+    ///
+    /// @brief      Get a byte within the buffer, doing a bounds check.
+    ///
+    /// @param      index           Index of the byte.
+    /// @throw      io_exception    When subscript is out of range.
+    ///
+    /// @return     Copy of a byte at @c index.
+    ///
+    template<std::size_t N>
+    typename small_buffer<N>::value_type
+    small_buffer<N>::at(size_type index) const
+    {
+        REIO_ASSERT(index < m_length, "subscript out of buffer range");
+        return m_begin[index];
+    }
+
+    ///
+    /// @brief      Get a view over a section of the active memory block.
+    ///
+    /// @param      offset          Number of bytes from the start of this buffer.
+    /// @param      size            Number of bytes in the resulting view.
+    /// @throw      io_exception    When @c offset or @c offset + @c size are out of bounds.
+    ///
+    /// @return     A view over @c size bytes in this buffer starting at @c offset.
+    ///
+    template<std::size_t N>
+    weak_buffer
+    small_buffer<N>::subview(size_type offset, size_type size) const
+    {
+        REIO_ASSERT(offset <= m_length, "subview offset out of buffer bounds");
+        REIO_ASSERT(offset + size <= m_length, "subview size bigger than buffer length");
+        return { m_begin + offset, size };
+    }
+
+    ///
+    /// @brief      Get a view over a starting section of the active memory block.
+    ///
+    /// @param      size            Number of bytes in the resulting view.
+    /// @throw      io_exception    When @c size is over the buffer's length.
+    ///
+    /// @return     A view over the first @c size bytes in this buffer.
+    ///
+    template<std::size_t N>
+    weak_buffer
+    small_buffer<N>::first(size_type size) const
+    {
+        REIO_ASSERT(size <= m_length, "subview size bigger than buffer length");
+        return { m_begin, size };
+    }
+
+    ///
+    /// @brief      Get a view over an ending section of the active memory block.
+    ///
+    /// @param      size            Number of bytes in the resulting view.
+    /// @throw      io_exception    When @c size is over the buffer's length.
+    ///
+    /// @return     A view over the last @c size bytes in this buffer.
+    ///
+    template<std::size_t N>
+    weak_buffer
+    small_buffer<N>::last(size_type size) const
+    {
+        REIO_ASSERT(size <= m_length, "subview size bigger than buffer length");
+        return { m_begin + m_length - size, size };
+    }
+
+    ///
+    /// @brief      Get a view over an ending section of the active memory block.
+    ///
+    /// @param      offset          Number of bytes from the start of this buffer.
+    /// @throw      io_exception    When @c offset is out of bounds.
+    ///
+    /// @return     A view over all the bytes past @c offset in this buffer.
+    ///
+    template<std::size_t N>
+    weak_buffer
+    small_buffer<N>::last_from(size_type offset) const
+    {
+        REIO_ASSERT(offset <= m_length, "subview offset out of buffer bounds");
+        return { m_begin + offset, m_length - offset };
+    }
+
+    ///
+    /// @brief      Overwrite a block within the buffer, possibly extending it.
+    ///
+    /// Source and destination blocks MUST NOT overlap.
+    ///
+    /// @param      src_begin       Iterator before the first source byte.
+    /// @param      src_end         Iterator past the last source byte.
+    /// @param      dest_begin      Iterator before the first byte to overwrite.
+    /// @throw      io_exception    When @c src_begin and @c src_end are misordered,
+    ///                             or when @c dest_begin is out of bounds.
+    ///
+    /// @return     Iterator past the last overwritten byte.
+    ///
+    template<std::size_t N>
+    template<std::contiguous_iterator ContigIt>
+    typename small_buffer<N>::iterator
+    small_buffer<N>::overwrite(ContigIt src_begin, ContigIt src_end, const_iterator dest_begin)
+    {
+        REIO_ASSERT(src_begin <= src_end, "source iterators are out of order");
+        REIO_ASSERT(iter_within(dest_begin), "destination iterator is out of buffer bounds");
+
+        const auto write_length = static_cast<size_type>(src_end - src_begin);
+        const auto write_offset = static_cast<size_type>(dest_begin - cbegin());
+
+        if (write_offset + write_length > m_capacity) {
+            do_realloc(next_capacity(/*over:*/write_offset + write_length));
+        }
+
+        m_length = std::max(m_length, write_offset + write_length);
+        return std::copy(src_begin, src_end, m_begin + write_offset);
+    }
+
+    ///
+    /// @brief      Insert a block of bytes into the buffer, possibly extending it.
+    ///
+    /// Source and destination blocks MUST NOT overlap.
+    ///
+    /// @param      src_begin       Iterator before the first inserted byte.
+    /// @param      src_end         Iterator past the last inserted byte.
+    /// @param      dest_begin      Iterator before the first byte to be moved by insertion.
+    /// @throw      io_exception    When @c src_begin and @c src_end are misordered,
+    ///                             or when @c dest_begin is out of bounds.
+    ///
+    /// @return     Iterator past the last inserted byte (within this buffer).
+    ///
+    template<std::size_t N>
+    template<std::contiguous_iterator ContigIt>
+    typename small_buffer<N>::iterator
+    small_buffer<N>::insert(ContigIt src_begin, ContigIt src_end, const_iterator dest_begin)
+    {
+        REIO_ASSERT(src_begin <= src_end, "source iterators are out of order");
+        REIO_ASSERT(iter_within(dest_begin), "destination iterator is out of buffer bounds");
+
+        const auto write_length = static_cast<size_type>(src_end - src_begin);
+        const auto write_offset = static_cast<size_type>(dest_begin - cbegin());
+
+        if (m_length + write_length > m_capacity) {
+            do_realloc(next_capacity(/*over:*/m_length + write_length));
+        }
+
+        const auto dest_iter = m_begin + write_offset;
+
+        std::copy_backward(dest_iter, m_begin + m_length, m_begin + m_length + write_length);
+        std::copy(src_begin, src_end, dest_iter);
+
+        m_length += write_length;
+        return dest_iter + write_length;
+    }
+
+    ///
+    /// @brief      Remove a sequence from the buffer.
+    ///
+    /// Memory is kept, so a heap buffer doesn't move back inline.
+    ///
+    /// @param      first   Iterator before the first byte to be removed.
+    /// @param      last    Iterator past the last byte to be removed.
+    ///
+    /// @return     Iterator before the first removed byte.
+    ///
+    template<std::size_t N>
+    typename small_buffer<N>::iterator
+    small_buffer<N>::erase(const_iterator first, const_iterator last)
+    {
+        REIO_ASSERT(iter_within(first) && iter_within(last), "destination iterators are out of buffer bounds");
+        REIO_ASSERT(first <= last, "can't erase from a misordered iterator pair");
+
+        const auto removal_start = m_begin + (first - cbegin());
+        const auto removal_length = static_cast<size_type>(last - first);
+
+        std::shift_left(removal_start, end(), static_cast<difference_type>(removal_length));
+        m_length -= removal_length;
+
+        return removal_start;
+    }
+
+    template<std::size_t N>
+    bool
+    small_buffer<N>::iter_within(const_iterator iter) const noexcept
+    {
+        return iter >= cbegin() && iter <= cend();
+    }
+
+    template<std::size_t N>
+    typename small_buffer<N>::size_type
+    small_buffer<N>::next_capacity(size_type over) const
+    {
+        switch (m_growth) {
+            case growth_factor::none:
+            {
+                REIO_FAIL("small buffer can't expand with 'none' growth factor",
+                          __FILE__, __LINE__, _REIO_FUNC_);
+            }
+            case growth_factor::tight:
+            {
+                return over;
+            }
+            case growth_factor::mult2x:
+            default:
+            {
+                size_type next = m_capacity;
+                while (next < over)
+                {
+                    next *= 2u;
+                }
+                return next;
+            }
+        }
+    }
+
+    template<std::size_t N>
+    void
+    small_buffer<N>::do_realloc(size_type new_capacity)
+    {
+        if (new_capacity <= m_capacity) {
+            return;
+        }
+
+        // leaving the inline storage is the only time contents are copied by hand
+        const pointer allocation = is_inline()
+            ? m_allocator->allocate(new_capacity)
+            : m_allocator->reallocate(m_begin, m_capacity, new_capacity, m_length);
+        REIO_ASSERT(allocation != nullptr, "small buffer failed to reallocate");
+
+        if (is_inline()) {
+            std::copy_n(m_inline, m_length, allocation);
+        }
+
+        m_begin = allocation;
+        m_capacity = new_capacity;
+    }
+
+    template<std::size_t N>
+    void
+    small_buffer<N>::take_over(small_buffer& other) noexcept
+    {
+        if (other.is_inline()) {
+            std::copy_n(other.m_inline, other.m_length, m_inline);
+            m_begin = m_inline;
+            m_capacity = N;
+        }
+        else {
+            m_begin = other.m_begin;
+            m_capacity = other.m_capacity;
+        }
+        m_length = other.m_length;
+
+        other.m_begin = other.m_inline;
+        other.m_length = 0u;
+        other.m_capacity = N;
+    }
+
+    template<std::size_t N>
+    void
+    small_buffer<N>::release() noexcept
+    {
+        if (!is_inline()) {
+            m_allocator->deallocate(m_begin, m_capacity);
+        }
+
+        m_begin = m_inline;
+        m_length = 0u;
+        m_capacity = N;
+    }
+
+}
+
+#endif //REIO_SMALL_BUFFER_HPP
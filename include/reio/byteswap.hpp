@@ -0,0 +1,130 @@
+#ifndef REIO_BYTESWAP_HPP
+#define REIO_BYTESWAP_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <span>
+
+#endif
+
+#include "./asserts.hpp"
+#include "./types.hpp"
+#include "./buffers/weak_buffer.hpp"
+
+
+namespace reio
+{
+
+    ///
+    /// Implementation used by bulk byte-swapping functions,
+    /// selected at runtime depending on what the CPU supports.
+    ///
+    enum class bswap_kernel : int
+    {
+        scalar = 1,             //< Portable loop over @c bswap.
+        ssse3 = 2,              //< 16 bytes per iteration with @c pshufb (x86).
+        avx2 = 3,               //< 32 bytes per iteration with @c vpshufb (x86).
+        neon = 4                //< 16 bytes per iteration with @c vrev (ARM).
+    };
+
+
+    ///
+    /// @brief      Get the kernel which is currently used by bulk byte-swapping functions.
+    /// @return     The fastest kernel supported by the CPU, unless another one was selected.
+    ///
+    [[nodiscard]] bswap_kernel active_bswap_kernel() noexcept;
+
+    ///
+    /// @brief      Check whether a kernel can be used on the current CPU.
+    /// @param      kernel    Kernel to check.
+    /// @return     Whether it was compiled in and is supported by the CPU.
+    ///
+    [[nodiscard]] bool is_bswap_kernel_supported(bswap_kernel kernel) noexcept;
+
+    ///
+    /// @brief      Override the kernel which is used by bulk byte-swapping functions.
+    ///
+    /// Mostly useful for testing and benchmarking, since the fastest supported kernel
+    /// is selected automatically. Not synchronized with concurrent byte-swapping calls.
+    ///
+    /// @param      kernel    Kernel to use from now on.
+    /// @return     Whether the kernel is supported and was selected.
+    ///
+    bool select_bswap_kernel(bswap_kernel kernel) noexcept;
+
+    ///
+    /// @brief      Reverse byte order in every element of a contiguous block.
+    ///
+    /// Source and destination may either be the same block, or not overlap at all.
+    ///
+    /// @param      width           Size (in bytes) of each element: 1, 2, 4 or 8.
+    /// @param      source          Pointer to the first element to convert.
+    /// @param      dest            Pointer to the first converted element.
+    /// @param      count           Number of elements to convert.
+    /// @throw      io_exception    If @c width is not one of the supported sizes.
+    ///
+    void bswap_bytes(std::size_t width, const byte* source, byte* dest, std::size_t count);
+
+
+    ///
+    /// @brief      Reverse byte order of all values in a buffer, in place.
+    ///
+    /// @tparam     T               Type of values stored in the buffer.
+    /// @param      buffer          Buffer to convert; its length must be a multiple of @c sizeof(T).
+    /// @throw      io_exception    If buffer length is not a multiple of @c sizeof(T).
+    ///
+    template<regular_numeric_type T>
+    void bswap_range(weak_buffer buffer)
+    {
+        REIO_ASSERT(buffer.length() % sizeof(T) == 0u, "buffer length is not a multiple of value size");
+        bswap_bytes(sizeof(T), buffer.data(), buffer.data(), buffer.length() / sizeof(T));
+    }
+
+    ///
+    /// @brief      Copy all values from one buffer to another, reversing their byte order.
+    ///
+    /// @tparam     T               Type of values stored in the buffers.
+    /// @param      source          Buffer to convert; its length must be a multiple of @c sizeof(T).
+    /// @param      dest            Buffer to write into; must be at least as long as @c source,
+    ///                             and either be @c source or not overlap it.
+    /// @throw      io_exception    If buffer lengths don't fit.
+    ///
+    template<regular_numeric_type T>
+    void bswap_range(weak_buffer source, weak_buffer dest)
+    {
+        REIO_ASSERT(source.length() % sizeof(T) == 0u, "buffer length is not a multiple of value size");
+        REIO_ASSERT(dest.length() >= source.length(), "destination buffer is too small");
+        bswap_bytes(sizeof(T), source.data(), dest.data(), source.length() / sizeof(T));
+    }
+
+    ///
+    /// @brief      Reverse byte order of all values in a span, in place.
+    /// @param      values    Values to convert.
+    ///
+    template<regular_numeric_type T>
+    void bswap_range(std::span<T> values)
+    {
+        bswap_bytes(sizeof(T), reinterpret_cast<const byte*>(values.data()),
+                    reinterpret_cast<byte*>(values.data()), values.size());
+    }
+
+    ///
+    /// @brief      Copy values from one span to another, reversing their byte order.
+    ///
+    /// @param      source          Values to convert.
+    /// @param      dest            Span to write into; must be at least as long as @c source,
+    ///                             and either be @c source or not overlap it.
+    /// @throw      io_exception    If @c dest is too small.
+    ///
+    template<regular_numeric_type T>
+    void bswap_range(std::span<const T> source, std::span<T> dest)
+    {
+        REIO_ASSERT(dest.size() >= source.size(), "destination span is too small");
+        bswap_bytes(sizeof(T), reinterpret_cast<const byte*>(source.data()),
+                    reinterpret_cast<byte*>(dest.data()), source.size());
+    }
+
+}
+
+#endif //REIO_BYTESWAP_HPP
@@ -0,0 +1,136 @@
+#ifndef REIO_IO_ENGINE_HPP
+#define REIO_IO_ENGINE_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <cstdint>
+#include <vector>
+
+#endif
+
+#include "./allocators.hpp"
+#include "./asserts.hpp"
+#include "./types.hpp"
+#include "./buffers/owning_buffer.hpp"
+#include "./buffers/weak_buffer.hpp"
+
+#ifndef REIO_PLATFORM_POSIX
+    #error I/O engine is only implemented for POSIX platforms
+#endif
+
+
+namespace reio
+{
+
+    static constexpr uint32_t k_default_io_queue_depth = 64u;
+
+
+    ///
+    /// Mechanism which is used by @c io_engine to execute requests.
+    ///
+    enum class io_backend : int
+    {
+        uring = 1,              //< Requests are batched into an io_uring instance (Linux 5.6+).
+        pread = 2               //< Requests are executed one by one with @c pread / @c pwrite when waited for.
+    };
+
+
+    ///
+    /// @brief      Options for @c io_engine.
+    ///
+    struct io_engine_options final
+    {
+        uint32_t        m_queue_depth = k_default_io_queue_depth;   //< Maximum number of requests in flight.
+        bool            m_force_fallback = false;                   //< Use the @c pread backend even if io_uring is available.
+    };
+
+
+    ///
+    /// @brief      Result of a request executed by @c io_engine.
+    ///
+    struct io_completion final
+    {
+        uint64_t        m_tag;          //< Value passed on submission.
+        int64_t         m_result;       //< Number of bytes transferred, or a negated @c errno value.
+        owning_buffer   m_buffer;       //< Bytes read, or the buffer which was written; empty for external buffers.
+    };
+
+
+    ///
+    /// @brief      Engine which executes batches of positional reads and writes on file descriptors.
+    ///
+    /// Requests are queued by @c submit_read / @c submit_write, and handed to the kernel together
+    /// on @c submit or @c wait, so reading thousands of small files costs a few syscalls per batch
+    /// rather than one per file. Completions come back in any order, identified by their tags. @n
+    ///
+    /// On Linux, io_uring is set up through raw syscalls (there is no liburing dependency).
+    /// Where it's unavailable (older kernels, seccomp filters, other platforms), the engine
+    /// falls back to executing requests with @c pread / @c pwrite in @c wait, with the same API. @n
+    ///
+    /// Like with @c pread, transfers may be short; at most one syscall is done per request.
+    /// The engine is not thread-safe.
+    ///
+    class io_engine final : public non_copyable
+    {
+    public:
+
+        /// @brief Mapped io_uring instance, opaque outside of the engine's implementation.
+        struct uring_state;
+
+    private:
+
+        struct request final
+        {
+            owning_buffer   m_buffer;
+            weak_buffer     m_target;
+            uint64_t        m_tag = 0u;
+            int64_t         m_offset = 0;
+            int             m_fd = -1;
+            bool            m_write = false;
+        };
+
+        io_engine_options               m_options;
+        base_allocator*                 m_allocator;
+        io_backend                      m_backend;
+        uring_state*                    m_uring;
+
+        std::vector<request>            m_requests;     //< Slot per request in flight.
+        std::vector<uint32_t>           m_free;         //< Indices of unused slots.
+        std::vector<uint32_t>           m_queued;       //< Indices of slots which weren't handed to the kernel yet.
+        std::vector<io_completion>      m_completed;    //< Completions reaped while making room for new requests.
+
+    public:
+
+        explicit io_engine(io_engine_options options = {},
+                           base_allocator* alloc = default_allocator::get_default());
+        ~io_engine() noexcept;
+
+        [[nodiscard]] static bool is_uring_supported() noexcept;
+
+        [[nodiscard]] io_backend backend() const noexcept;
+        [[nodiscard]] uint32_t queue_depth() const noexcept;
+        [[nodiscard]] std::size_t in_flight() const noexcept;
+
+        void submit_read(int fd, int64_t offset, std::size_t size, uint64_t tag);
+        void submit_read(int fd, int64_t offset, weak_buffer output, uint64_t tag);
+        void submit_write(int fd, int64_t offset, owning_buffer input, uint64_t tag);
+
+        std::size_t submit();
+        std::size_t wait(std::vector<io_completion>& completions, std::size_t min_count = 1u);
+
+    private:
+
+        uint32_t acquire_slot();
+        void enqueue(uint32_t index);
+        io_completion complete(uint32_t index, int64_t result);
+
+        std::size_t submit_uring(uint32_t min_complete);
+        void reap_uring(std::vector<io_completion>& completions);
+        void execute_fallback(std::vector<io_completion>& completions);
+
+    };
+
+}
+
+#endif //REIO_IO_ENGINE_HPP
@@ -0,0 +1,445 @@
+#ifndef REIO_ASYNC_STREAMS_HPP
+#define REIO_ASYNC_STREAMS_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#endif
+
+#include "../asserts.hpp"
+#include "../io_engine.hpp"
+#include "../types.hpp"
+#include "../buffers/weak_buffer.hpp"
+#include "./streams.hpp"
+
+#ifndef REIO_PLATFORM_POSIX
+    #error Asynchronous streams are only implemented for POSIX platforms
+#endif
+
+
+namespace reio
+{
+
+    template<typename T = void>
+    class task;
+
+
+    ///
+    /// @brief      Part of coroutine promise shared by all @c task types.
+    ///
+    /// Tasks start suspended, and resume whoever awaited them once they finish.
+    ///
+    class task_promise_base
+    {
+    public:
+
+        struct final_awaiter final
+        {
+            [[nodiscard]] bool await_ready() const noexcept { return false; }
+            void await_resume() const noexcept {}
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+            {
+                const auto continuation = handle.promise().m_continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+        };
+
+        std::coroutine_handle<>     m_continuation;
+        std::exception_ptr          m_error;
+
+        [[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+        [[nodiscard]] final_awaiter final_suspend() const noexcept { return {}; }
+        void unhandled_exception() noexcept { m_error = std::current_exception(); }
+    };
+
+    template<typename T>
+    class task_promise final : public task_promise_base
+    {
+    public:
+
+        std::optional<T>    m_value;
+
+        [[nodiscard]] task<T> get_return_object() noexcept;
+
+        template<std::convertible_to<T> U>
+        void return_value(U&& value) { m_value.emplace(std::forward<U>(value)); }
+
+        T result()
+        {
+            if (m_error)
+            {
+                std::rethrow_exception(m_error);
+            }
+            return std::move(*m_value);
+        }
+    };
+
+    template<>
+    class task_promise<void> final : public task_promise_base
+    {
+    public:
+
+        [[nodiscard]] task<void> get_return_object() noexcept;
+
+        void return_void() const noexcept {}
+
+        void result() const
+        {
+            if (m_error)
+            {
+                std::rethrow_exception(m_error);
+            }
+        }
+    };
+
+
+    ///
+    /// @brief      Lazily-started coroutine which produces a value (or an exception).
+    ///
+    /// A task runs once it's @c co_await -ed by another coroutine, or handed to an @c event_loop.
+    /// Awaiting a task resumes the awaiter right after the task finishes, without going
+    /// through the loop. The task owns its coroutine frame.
+    ///
+    /// @tparam     T    Type of the result, or @c void.
+    ///
+    /// @ingroup    streams
+    ///
+    template<typename T>
+    class task final : public non_copyable
+    {
+    public:
+
+        using promise_type  = task_promise<T>;
+        using handle_type   = std::coroutine_handle<promise_type>;
+
+    private:
+
+        handle_type     m_handle;
+
+    public:
+
+        explicit task(handle_type handle) noexcept
+            : m_handle{ handle } {}
+
+        task(task&& other) noexcept
+            : m_handle{ std::exchange(other.m_handle, nullptr) } {}
+
+        task& operator=(task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (m_handle)
+                {
+                    m_handle.destroy();
+                }
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+            return *this;
+        }
+
+        ~task()
+        {
+            if (m_handle)
+            {
+                m_handle.destroy();
+            }
+        }
+
+        [[nodiscard]] handle_type handle() const noexcept { return m_handle; }
+        [[nodiscard]] bool done() const noexcept { return m_handle && m_handle.done(); }
+
+        ///
+        /// @brief      Get the result of a finished task.
+        /// @throw      ...     Exception which escaped the task.
+        ///
+        T result() { return m_handle.promise().result(); }
+
+        [[nodiscard]] auto operator co_await() && noexcept
+        {
+            struct awaiter final
+            {
+                handle_type     m_handle;
+
+                [[nodiscard]] bool await_ready() const noexcept { return m_handle.done(); }
+                T await_resume() { return m_handle.promise().result(); }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+                {
+                    m_handle.promise().m_continuation = awaiting;
+                    return m_handle;
+                }
+            };
+
+            return awaiter{ m_handle };
+        }
+    };
+
+    template<typename T>
+    task<T>
+    task_promise<T>::get_return_object() noexcept
+    {
+        return task<T>{ std::coroutine_handle<task_promise<T>>::from_promise(*this) };
+    }
+
+    inline task<void>
+    task_promise<void>::get_return_object() noexcept
+    {
+        return task<void>{ std::coroutine_handle<task_promise<void>>::from_promise(*this) };
+    }
+
+
+    ///
+    /// @brief      State of a single stream operation awaited through an @c event_loop.
+    ///
+    struct async_operation final
+    {
+        std::coroutine_handle<>     m_handle;
+        std::function<int64_t()>    m_blocking;             //< Operation to run on a worker thread, if not done by the engine.
+        input_stream*               m_stream = nullptr;     //< Stream to advance once an engine read completes.
+        int64_t                     m_result = 0;
+        std::exception_ptr          m_error;
+    };
+
+
+    ///
+    /// @brief      Options for @c event_loop.
+    ///
+    struct event_loop_options final
+    {
+        uint32_t        m_queue_depth = 256u;       //< Maximum number of engine reads in flight.
+        std::size_t     m_worker_count = 2u;        //< Number of threads for operations which can't be done by the engine.
+        bool            m_force_fallback = false;   //< Don't use io_uring, see @c io_engine_options.
+    };
+
+
+    ///
+    /// @brief      Single-threaded loop which runs coroutines awaiting stream operations.
+    ///
+    /// All coroutines run on the thread which calls @c run, and are only resumed once their
+    /// operations complete, so thousands of them can be in flight without a thread each. @n
+    ///
+    /// Reads from @c fd_input_stream are submitted to an @c io_engine, so all reads which were
+    /// issued during one pass of the loop cost a single @c io_uring_enter. Other operations
+    /// (writes, and reads from other streams) are run on a small pool of worker threads,
+    /// whose completions wake the loop up. @n
+    ///
+    /// A stream may only have a single operation in flight at a time. Destroying the loop waits
+    /// for engine reads which unfinished tasks still have in flight, but doesn't resume them.
+    ///
+    /// @ingroup    streams
+    ///
+    class event_loop final : public non_copyable
+    {
+    private:
+
+        std::vector<io_completion>              m_completions;
+        std::deque<std::coroutine_handle<>>     m_ready;
+        std::vector<task<void>>                 m_tasks;
+        io_engine                               m_engine;           //< Destroyed before the tasks, whose frames own the buffers of its reads.
+        std::exception_ptr                      m_task_error;
+        std::size_t                             m_engine_ops;
+        std::size_t                             m_blocking_ops;
+
+        int                                     m_wakeup[2];
+        bool                                    m_wakeup_armed;
+        byte                                    m_wakeup_buffer[64];
+
+        std::mutex                              m_mutex;
+        std::condition_variable                 m_work;
+        std::condition_variable                 m_finished;
+        std::deque<async_operation*>            m_jobs;
+        std::deque<async_operation*>            m_done;
+        bool                                    m_stopping;
+        std::vector<std::thread>                m_workers;
+
+    public:
+
+        explicit event_loop(event_loop_options options = {});
+        ~event_loop() noexcept;
+
+        [[nodiscard]] static event_loop* current() noexcept;
+        [[nodiscard]] const io_engine& engine() const noexcept;
+
+        void spawn(task<void> detached);
+        void run();
+
+        template<typename T>
+        T run(task<T> main);
+
+        void schedule_read(async_operation& operation, input_stream& stream, weak_buffer output);
+        void schedule_blocking(async_operation& operation);
+
+    private:
+
+        class scope;
+
+        void step();
+        void collect_tasks();
+        void wait_for_events();
+        void drain_blocking();
+        void worker_main();
+        void stop_workers() noexcept;
+
+        [[nodiscard]] bool has_pending() const noexcept;
+    };
+
+
+    ///
+    /// @brief      Sets the loop which is returned by @c event_loop::current for a scope.
+    ///
+    class event_loop::scope final : public non_copyable
+    {
+    private:
+
+        event_loop*     m_previous;
+
+    public:
+
+        explicit scope(event_loop* loop) noexcept;
+        ~scope() noexcept;
+    };
+
+
+    ///
+    /// @brief      Run a task on the loop, and wait until it finishes.
+    ///
+    /// Spawned tasks make progress in the meantime, but aren't waited for.
+    ///
+    /// @param      main            Task to run.
+    /// @throw      io_exception    If the task waits on something which the loop doesn't know about.
+    /// @throw      ...             Exception which escaped the task.
+    ///
+    /// @return     Result of the task.
+    ///
+    template<typename T>
+    T
+    event_loop::run(task<T> main)
+    {
+        const scope current{ this };
+        m_ready.push_back(main.handle());
+
+        while (!main.done())
+        {
+            REIO_ASSERT(!m_ready.empty() || has_pending(), "task is blocked on something outside of the event loop");
+            step();
+        }
+
+        return main.result();
+    }
+
+
+    ///
+    /// @brief      Awaitable which reads from an input stream through the current @c event_loop.
+    ///
+    class async_read_awaiter final
+    {
+    private:
+
+        async_operation     m_operation;
+        input_stream*       m_stream;
+        weak_buffer         m_output;
+
+    public:
+
+        async_read_awaiter(input_stream& stream, weak_buffer output) noexcept
+            : m_stream{ &stream }, m_output{ output } {}
+
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        int64_t await_resume();
+    };
+
+
+    ///
+    /// @brief      Awaitable which writes into an output stream through the current @c event_loop.
+    ///
+    class async_write_awaiter final
+    {
+    private:
+
+        async_operation     m_operation;
+
+    public:
+
+        async_write_awaiter(output_stream& stream, weak_buffer input);
+
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        int64_t await_resume();
+    };
+
+
+    ///
+    /// @brief      Get up to a certain number of bytes from a stream without blocking the loop,
+    ///             and advance its cursor.
+    ///
+    /// Must be awaited by a coroutine which runs on an @c event_loop.
+    ///
+    /// @param      stream    Stream to read from.
+    /// @param      output    View of memory to read into; defines the number of bytes to read.
+    /// @return     Awaitable producing the number of bytes successfully read.
+    ///
+    [[nodiscard]] inline async_read_awaiter
+    async_read_bytes(input_stream& stream, weak_buffer output) noexcept
+    {
+        return { stream, output };
+    }
+
+    ///
+    /// @brief      Write bytes into a stream without blocking the loop, and advance its cursor.
+    ///
+    /// Must be awaited by a coroutine which runs on an @c event_loop.
+    ///
+    /// @param      stream    Stream to write into.
+    /// @param      input     View of memory to write; implicitly defines the written number of bytes.
+    /// @return     Awaitable producing the number of bytes successfully written.
+    ///
+    [[nodiscard]] inline async_write_awaiter
+    async_write_bytes(output_stream& stream, weak_buffer input)
+    {
+        return { stream, input };
+    }
+
+    ///
+    /// @brief      Read a numeric value without blocking the loop, doing endianness conversion if needed.
+    ///
+    /// @tparam     T               Type of the numeric value to read.
+    /// @tparam     E               Endianness which was used to encode the value.
+    /// @param      stream          Stream to read from.
+    /// @throw      io_exception    If there isn't enough bytes.
+    ///
+    /// @return     Task producing the value.
+    ///
+    template<numeric_type T, std::endian E = std::endian::native>
+    task<T>
+    async_read_numeric(input_stream& stream)
+    {
+        auto value = T{ 0u };
+
+        [[maybe_unused]] const auto read = co_await async_read_bytes(stream, weak_buffer{ reinterpret_cast<byte*>(&value), sizeof(T) });
+        REIO_ASSERT(read == sizeof(T), "failed to read enough bytes for a numeric value");
+
+        if constexpr (E != std::endian::native)
+        {
+            value = bswap(value);
+        }
+
+        co_return value;
+    }
+
+}
+
+#endif //REIO_ASYNC_STREAMS_HPP
@@ -0,0 +1,180 @@
+#ifndef REIO_BUFFERED_STREAMS_HPP
+#define REIO_BUFFERED_STREAMS_HPP
+
+#include "../allocators.hpp"
+#include "../asserts.hpp"
+#include "../types.hpp"
+#include "../buffers/owning_buffer.hpp"
+#include "../buffers/weak_buffer.hpp"
+#include "./streams.hpp"
+
+
+namespace reio
+{
+
+    /// @brief Default size (in bytes) of the internal window of buffered streams.
+    static constexpr std::size_t k_default_buffered_window = 64u * 1024u;
+
+
+    ///
+    /// @brief      Decorator for @c input_stream which serves reads
+    ///             from an internal window refilled in large blocks.
+    ///
+    /// Small reads (numbers, headers, single bytes) are copied out of the
+    /// window without touching the wrapped stream, while reads which are
+    /// at least as big as the window go straight to the wrapped stream. @n
+    ///
+    /// The wrapped stream is not owned, and must outlive the decorator.
+    /// It shouldn't be used directly while the decorator is alive,
+    /// since its cursor is ahead of the decorator's one by design. @n
+    ///
+    /// @ingroup    streams
+    ///
+    class buffered_input_stream final
+        : public input_stream
+        , public non_copyable
+    {
+    private:
+
+        input_stream*   m_source;
+        owning_buffer   m_window;
+        int64_t         m_window_start;     //< Position of the window's first byte in the wrapped stream.
+        std::size_t     m_window_length;    //< Number of valid bytes in the window.
+        std::size_t     m_cursor;           //< Offset of the next byte to read within the window.
+
+    public:
+
+        ///
+        /// @brief      Initialize stream by wrapping another input stream.
+        ///
+        /// @param      source    Stream to read from; its current position becomes the initial one.
+        /// @param      window    Size (in bytes) of the internal window.
+        /// @param      alloc     Allocator which should be used for the window.
+        ///
+        explicit buffered_input_stream(input_stream* source,
+                                       std::size_t window = k_default_buffered_window,
+                                       base_allocator* alloc = default_allocator::get_default());
+
+        ~buffered_input_stream() override;
+
+        [[nodiscard]] input_stream* source() const noexcept;
+        [[nodiscard]] std::size_t window_capacity() const noexcept;
+        [[nodiscard]] weak_buffer window() const noexcept;
+
+        /// @brief      Borrow bytes from the current window, which is never refilled here; see @c consumable_source.
+        [[nodiscard]] byte* try_consume(std::size_t size) noexcept;
+
+        //* Implementation of base_stream.
+        //* ========================================
+
+        int64_t position() override;
+        int64_t length() override;
+        void seek_begin(int64_t offset) override;
+        void seek_current(int64_t offset) override;
+        void seek_end(int64_t offset) override;
+
+        //* Implementation of input_stream.
+        //* ========================================
+
+        int64_t read_bytes(weak_buffer output) override;
+        int64_t read_byte() override;
+
+    private:
+
+        [[nodiscard]] bool try_seek_within(int64_t target) noexcept;
+        void drop_window() noexcept;
+        std::size_t refill();
+
+    };
+
+
+    ///
+    /// @brief      Decorator for @c output_stream which accumulates writes
+    ///             in an internal window and flushes them in large blocks.
+    ///
+    /// Seeks which land within the pending (not yet flushed) block only
+    /// move the cursor, so back-patching recently written headers doesn't
+    /// cost a flush; other seeks flush the pending block first. Writes which
+    /// are at least as big as the window go straight to the wrapped stream. @n
+    ///
+    /// Since bytes are accepted before they reach the wrapped stream,
+    /// failures of the latter are only detected on flush. The pending block
+    /// is flushed on destruction, but call @c flush explicitly to be
+    /// notified of such failures. @n
+    ///
+    /// The wrapped stream is not owned, and must outlive the decorator.
+    ///
+    /// @ingroup    streams
+    ///
+    class buffered_output_stream final
+        : public output_stream
+        , public non_copyable
+    {
+    private:
+
+        output_stream*  m_sink;
+        owning_buffer   m_window;
+        int64_t         m_window_start;     //< Position of the window's first byte in the wrapped stream.
+        std::size_t     m_window_length;    //< Number of pending bytes in the window.
+        std::size_t     m_cursor;           //< Offset of the next byte to write within the window.
+
+    public:
+
+        ///
+        /// @brief      Initialize stream by wrapping another output stream.
+        ///
+        /// @param      sink      Stream to write to; its current position becomes the initial one.
+        /// @param      window    Size (in bytes) of the internal window.
+        /// @param      alloc     Allocator which should be used for the window.
+        ///
+        explicit buffered_output_stream(output_stream* sink,
+                                        std::size_t window = k_default_buffered_window,
+                                        base_allocator* alloc = default_allocator::get_default());
+
+        ~buffered_output_stream() override;
+
+        [[nodiscard]] output_stream* sink() const noexcept;
+        [[nodiscard]] std::size_t window_capacity() const noexcept;
+        [[nodiscard]] weak_buffer window() const noexcept;
+
+        void flush();
+
+        //* Implementation of base_stream.
+        //* ========================================
+
+        int64_t position() override;
+        int64_t length() override;
+        void seek_begin(int64_t offset) override;
+        void seek_current(int64_t offset) override;
+        void seek_end(int64_t offset) override;
+
+        //* Implementation of output_stream.
+        //* ========================================
+
+        int64_t write_bytes(weak_buffer input) override;
+        bool write_byte(byte value) override;
+
+    private:
+
+        [[nodiscard]] bool try_seek_within(int64_t target) noexcept;
+        [[nodiscard]] bool write_window();
+
+    };
+
+
+    inline byte*
+    buffered_input_stream::try_consume(std::size_t size) noexcept
+    {
+        if (m_window_length - m_cursor < size)
+        {
+            return nullptr;
+        }
+
+        const auto data = m_window.data() + m_cursor;
+        m_cursor += size;
+        return data;
+    }
+
+}
+
+#endif //REIO_BUFFERED_STREAMS_HPP
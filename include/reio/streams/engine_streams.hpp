@@ -0,0 +1,79 @@
+#ifndef REIO_ENGINE_STREAMS_HPP
+#define REIO_ENGINE_STREAMS_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <span>
+#include <string_view>
+
+#endif
+
+#include "../asserts.hpp"
+#include "../io_engine.hpp"
+#include "../types.hpp"
+#include "../buffers/weak_buffer.hpp"
+#include "./streams.hpp"
+
+#ifndef REIO_PLATFORM_POSIX
+    #error Engine-backed streams are only implemented for POSIX platforms
+#endif
+
+
+namespace reio
+{
+
+    ///
+    /// @brief      Implementation of @c input_stream reading a file descriptor through an @c io_engine.
+    ///
+    /// Synchronous facade for code which expects an @c input_stream: every read is submitted to
+    /// the stream's own engine and waited for, straight into the caller's memory. Scattered reads
+    /// are submitted as a single batch, so they cost one @c io_uring_enter for many buffers.
+    /// Where io_uring is unavailable, the engine (and so the stream) falls back to @c pread. @n
+    ///
+    /// Positions and seeking behave exactly like with @c fd_input_stream.
+    ///
+    /// @ingroup    streams
+    ///
+    class engine_input_stream final
+        : public input_stream
+        , public non_copyable
+    {
+    private:
+
+        io_engine       m_engine;
+        int             m_fd = -1;
+        int64_t         m_position = 0;
+        int64_t         m_length = 0;
+
+    public:
+
+        explicit engine_input_stream(int fd, io_engine_options options = {});
+        explicit engine_input_stream(std::string_view path, int extra_flags = 0, io_engine_options options = {});
+
+        ~engine_input_stream() override;
+
+        [[nodiscard]] int fd() const noexcept;
+        [[nodiscard]] const io_engine& engine() const noexcept;
+
+        int64_t refresh_length();
+
+        //* Implementation of base_stream.
+        //* ========================================
+
+        int64_t position() override;
+        int64_t length() override;
+        void seek_begin(int64_t offset) override;
+        void seek_current(int64_t offset) override;
+        void seek_end(int64_t offset) override;
+
+        //* Implementation of input_stream.
+        //* ========================================
+
+        int64_t read_bytes(weak_buffer output) override;
+        int64_t read_bytes_scatter(std::span<const weak_buffer> outputs) override;
+    };
+
+}
+
+#endif //REIO_ENGINE_STREAMS_HPP
@@ -0,0 +1,182 @@
+#ifndef REIO_FD_STREAMS_HPP
+#define REIO_FD_STREAMS_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <string>
+
+#endif
+
+#include "../allocators.hpp"
+#include "../asserts.hpp"
+#include "../types.hpp"
+#include "../buffers/owning_buffer.hpp"
+#include "../buffers/weak_buffer.hpp"
+#include "./random_access.hpp"
+#include "./streams.hpp"
+
+#ifndef REIO_PLATFORM_POSIX
+    #error Descriptor-based streams are only implemented for POSIX platforms
+#endif
+
+
+namespace reio
+{
+
+    /// @brief Alignment of offsets, sizes and memory which @c O_DIRECT transfers require.
+    static constexpr std::size_t k_direct_io_alignment = k_default_block_alignment;
+
+    /// @brief Size of the aligned buffer which fd streams use to split unaligned @c O_DIRECT transfers.
+    static constexpr std::size_t k_direct_io_buffer_size = 1024u * 1024u;
+
+
+    ///
+    /// @brief      Implementation of @c input_stream using
+    ///             a POSIX file descriptor as a data source.
+    ///
+    /// Unlike @c file_input_stream, there is no CRT buffer or lock in between:
+    /// every read is a single @c pread at the stream's own position,
+    /// so the descriptor's file offset is never used or changed. @n
+    ///
+    /// The descriptor is exposed through @c fd, e.g. for @c posix_fadvise.
+    /// Positions are 64-bit regardless of the size of @c long. @n
+    ///
+    /// File length is queried once on initialization, so @c length is O(1);
+    /// use @c refresh_length if the file can grow while it's being read. @n
+    ///
+    /// Descriptors opened with @c O_DIRECT bypass the page cache. Reads whose offset,
+    /// size and memory are aligned to @c k_direct_io_alignment go straight to the device,
+    /// others (and the file tail) are read in aligned chunks through an internal buffer. @n
+    ///
+    /// @ingroup    streams
+    ///
+    class fd_input_stream final
+        : public input_stream
+        , public random_access_source
+        , public non_copyable
+    {
+    private:
+
+        int             m_fd = -1;
+        int64_t         m_position = 0;
+        int64_t         m_length = 0;
+        bool            m_direct = false;
+        owning_buffer   m_direct_buffer;
+
+    public:
+
+        explicit fd_input_stream(int fd);
+        explicit fd_input_stream(std::string_view path, int extra_flags = 0);
+
+        ~fd_input_stream() override;
+
+        fd_input_stream(fd_input_stream&& other) noexcept;
+        fd_input_stream& operator=(fd_input_stream&& other) noexcept;
+
+        [[nodiscard]] int fd() const noexcept;
+        [[nodiscard]] int release() noexcept;
+        [[nodiscard]] bool is_direct() const noexcept;
+
+        int64_t refresh_length();
+
+        //* Implementation of base_stream.
+        //* ========================================
+
+        int64_t position() override;
+        int64_t length() override;
+        void seek_begin(int64_t offset) override;
+        void seek_current(int64_t offset) override;
+        void seek_end(int64_t offset) override;
+
+        //* Implementation of input_stream.
+        //* ========================================
+
+        int64_t read_bytes(weak_buffer output) override;
+        int64_t read_bytes_scatter(std::span<const weak_buffer> outputs) override;
+
+        //* Implementation of random_access_source.
+        //* ========================================
+
+        [[nodiscard]] int64_t size() const override;
+        int64_t read_at(int64_t offset, weak_buffer output) const override;
+    };
+
+
+    ///
+    /// @brief      Implementation of @c output_stream using
+    ///             a POSIX file descriptor as a data sink.
+    ///
+    /// Every write is a single @c pwrite at the stream's own position,
+    /// without a CRT buffer in between, so there is nothing to flush.
+    /// Append-mode descriptors are not supported, since positional writes
+    /// ignore their offset. @n
+    ///
+    /// The descriptor is exposed through @c fd, e.g. for @c fallocate or @c fsync. @n
+    ///
+    /// File length is queried once on initialization and then extended by writes
+    /// past the end, so @c length is O(1); use @c refresh_length if the file
+    /// can be modified elsewhere (e.g. truncated through @c fd). @n
+    ///
+    /// Descriptors opened with @c O_DIRECT bypass the page cache, and must be readable.
+    /// Aligned writes go straight to the device, others are collected in an internal
+    /// buffer and written as whole blocks, merging partial blocks with what's on disk.
+    /// The buffer is written out on @c flush, when writing somewhere else, and on destruction;
+    /// the file is then truncated back to its length if the last block was padded. @n
+    ///
+    /// @ingroup    streams
+    ///
+    class fd_output_stream final
+        : public output_stream
+        , public non_copyable
+    {
+    private:
+
+        int             m_fd = -1;
+        int64_t         m_position = 0;
+        int64_t         m_length = 0;
+        bool            m_direct = false;
+        owning_buffer   m_direct_buffer;
+        int64_t         m_buffered_offset = 0;
+        std::size_t     m_buffered = 0u;
+
+    public:
+
+        explicit fd_output_stream(int fd);
+        explicit fd_output_stream(std::string_view path, int extra_flags = 0);
+
+        ~fd_output_stream() override;
+
+        fd_output_stream(fd_output_stream&& other) noexcept;
+        fd_output_stream& operator=(fd_output_stream&& other) noexcept;
+
+        [[nodiscard]] int fd() const noexcept;
+        [[nodiscard]] int release() noexcept;
+        [[nodiscard]] bool is_direct() const noexcept;
+
+        int64_t refresh_length();
+        void flush();
+
+        //* Implementation of base_stream.
+        //* ========================================
+
+        int64_t position() override;
+        int64_t length() override;
+        void seek_begin(int64_t offset) override;
+        void seek_current(int64_t offset) override;
+        void seek_end(int64_t offset) override;
+
+        //* Implementation of output_stream.
+        //* ========================================
+
+        int64_t write_bytes(weak_buffer input) override;
+        int64_t write_bytes_gather(std::span<const weak_buffer> inputs) override;
+
+    private:
+
+        int64_t write_direct(weak_buffer input);
+    };
+
+}
+
+#endif //REIO_FD_STREAMS_HPP
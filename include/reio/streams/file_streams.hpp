@@ -19,6 +19,9 @@ namespace reio
     /// @brief      Implementation of @c input_stream using
     ///             a CRT file handle as a data source.
     ///
+    /// File length is queried once on initialization, so @c length is O(1);
+    /// use @c refresh_length if the file can grow while it's being read.
+    ///
     /// @ingroup    streams
     ///
     class file_input_stream final
@@ -28,6 +31,7 @@ namespace reio
     private:
 
         std::FILE* m_handle = nullptr;
+        int64_t m_length = 0;
 
     public:
 
@@ -36,6 +40,8 @@ namespace reio
 
         ~file_input_stream() override;
 
+        int64_t refresh_length();
+
         //* Implementation of base_stream.
         //* ========================================
 
@@ -49,6 +55,7 @@ namespace reio
         //* ========================================
 
         int64_t read_bytes(weak_buffer output) override;
+        int64_t read_bytes_scatter(std::span<const weak_buffer> outputs) override;
     };
 
 
@@ -56,6 +63,10 @@ namespace reio
     /// @brief      Implementation of @c input_stream using
     ///             a CRT file handle as a data sink.
     ///
+    /// Position and length are tracked by the stream itself (length is extended
+    /// by writes past the end), so both are O(1); use @c refresh_length
+    /// if the file can be modified elsewhere.
+    ///
     /// @ingroup    streams
     ///
     class file_output_stream final
@@ -65,6 +76,9 @@ namespace reio
     private:
 
         std::FILE* m_handle = nullptr;
+        int64_t m_position = 0;
+        int64_t m_length = 0;
+        bool m_append = false;      //< Writes land at the end of file regardless of position.
 
     public:
 
@@ -73,6 +87,8 @@ namespace reio
 
         ~file_output_stream() override;
 
+        int64_t refresh_length();
+
         //* Implementation of base_stream.
         //* ========================================
 
@@ -87,6 +103,7 @@ namespace reio
         //* ========================================
 
         int64_t write_bytes(weak_buffer input) override;
+        int64_t write_bytes_gather(std::span<const weak_buffer> inputs) override;
 
     };
 
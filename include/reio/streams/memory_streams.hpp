@@ -5,6 +5,7 @@
 #include "../types.hpp"
 #include "../buffers/owning_buffer.hpp"
 #include "../buffers/weak_buffer.hpp"
+#include "./random_access.hpp"
 #include "./streams.hpp"
 
 
@@ -19,6 +20,7 @@ namespace reio
     ///
     class memory_input_stream final
         : public input_stream
+        , public random_access_source
         , public non_copyable
     {
     private:
@@ -51,6 +53,71 @@ namespace reio
         [[nodiscard]] int64_t capacity() const noexcept;
         [[nodiscard]] growth_factor growth() const noexcept;
 
+        /// @brief      Borrow bytes straight from the buffer, see @c consumable_source.
+        [[nodiscard]] byte* try_consume(std::size_t size) noexcept;
+
+        //* Implementation of base_stream.
+        //* ========================================
+
+        int64_t position() override;
+        int64_t length() override;
+        void seek_begin(int64_t offset) override;
+        void seek_current(int64_t offset) override;
+        void seek_end(int64_t offset) override;
+
+        //* Implementation of input_stream.
+        //* ========================================
+
+        int64_t read_bytes(weak_buffer output) override;
+        std::optional<weak_buffer> try_read_view(std::size_t size) override;
+
+        //* Implementation of random_access_source.
+        //* ========================================
+
+        [[nodiscard]] int64_t size() const override;
+        int64_t read_at(int64_t offset, weak_buffer output) const override;
+        [[nodiscard]] std::optional<weak_buffer> view_at(int64_t offset, std::size_t size) const override;
+
+    };
+
+
+    ///
+    /// @brief      Implementation of @c input_stream reading
+    ///             straight from a caller-owned block of memory.
+    ///
+    /// Works just like @c memory_input_stream, but doesn't allocate
+    /// or copy anything. The viewed block must outlive the stream.
+    ///
+    /// @ingroup    streams
+    ///
+    class view_input_stream final
+        : public input_stream
+        , public random_access_source
+        , public non_copyable
+    {
+    private:
+
+        weak_buffer     m_view;
+        int64_t         m_position;
+
+    public:
+
+        ///
+        /// @brief      Initialize stream with a view of the data block to read.
+        /// @param      source_view    View of the data block, which is NOT copied.
+        ///
+        explicit view_input_stream(weak_buffer source_view);
+
+        ~view_input_stream() override;
+
+        view_input_stream(view_input_stream&& other) noexcept;
+        view_input_stream& operator=(view_input_stream&& other) noexcept;
+
+        [[nodiscard]] weak_buffer view() const noexcept;
+
+        /// @brief      Borrow bytes straight from the viewed block, see @c consumable_source.
+        [[nodiscard]] byte* try_consume(std::size_t size) noexcept;
+
         //* Implementation of base_stream.
         //* ========================================
 
@@ -64,6 +131,14 @@ namespace reio
         //* ========================================
 
         int64_t read_bytes(weak_buffer output) override;
+        std::optional<weak_buffer> try_read_view(std::size_t size) override;
+
+        //* Implementation of random_access_source.
+        //* ========================================
+
+        [[nodiscard]] int64_t size() const override;
+        int64_t read_at(int64_t offset, weak_buffer output) const override;
+        [[nodiscard]] std::optional<weak_buffer> view_at(int64_t offset, std::size_t size) const override;
 
     };
 
@@ -134,6 +209,33 @@ namespace reio
         int64_t write_bytes(weak_buffer input) override;
     };
 
+
+    inline byte*
+    memory_input_stream::try_consume(std::size_t size) noexcept
+    {
+        if (m_buffer.length() - static_cast<std::size_t>(m_position) < size)
+        {
+            return nullptr;
+        }
+
+        const auto data = m_buffer.data() + m_position;
+        m_position += static_cast<int64_t>(size);
+        return data;
+    }
+
+    inline byte*
+    view_input_stream::try_consume(std::size_t size) noexcept
+    {
+        if (m_view.length() - static_cast<std::size_t>(m_position) < size)
+        {
+            return nullptr;
+        }
+
+        const auto data = m_view.data() + m_position;
+        m_position += static_cast<int64_t>(size);
+        return data;
+    }
+
 }
 
 #endif //REIO_MEMORY_STREAMS_HPP
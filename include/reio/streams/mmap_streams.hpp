@@ -0,0 +1,141 @@
+#ifndef REIO_MMAP_STREAMS_HPP
+#define REIO_MMAP_STREAMS_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <string>
+
+#endif
+
+#include "../asserts.hpp"
+#include "../types.hpp"
+#include "../buffers/weak_buffer.hpp"
+#include "./random_access.hpp"
+#include "./streams.hpp"
+
+#ifndef REIO_PLATFORM_POSIX
+    #error Memory-mapped streams are only implemented for POSIX platforms
+#endif
+
+
+namespace reio
+{
+
+    ///
+    /// Access pattern hint passed to the kernel for a mapped file range.
+    ///
+    enum class mmap_advice : int
+    {
+        normal = 1,             //< No special treatment (MADV_NORMAL).
+        sequential = 2,         //< Aggressive read-ahead, pages can be freed soon after access (MADV_SEQUENTIAL).
+        random = 3,             //< Read-ahead is mostly useless (MADV_RANDOM).
+        willneed = 4,           //< Range will be accessed soon, start reading it in (MADV_WILLNEED).
+        dontneed = 5            //< Range won't be accessed soon (MADV_DONTNEED).
+    };
+
+
+    ///
+    /// @brief      Mapping options for @c mmap_input_stream.
+    ///
+    struct mmap_options final
+    {
+        bool            m_populate = false;                 //< Prefault the whole mapping (MAP_POPULATE, Linux only).
+        mmap_advice     m_advice = mmap_advice::normal;     //< Initial access pattern hint for the whole mapping.
+    };
+
+
+    ///
+    /// @brief      Implementation of @c input_stream using
+    ///             a read-only memory-mapped file as a data source.
+    ///
+    /// Reads are plain copies out of the mapping, and @c view allows
+    /// to access parts of the file without copying at all. Seek and read
+    /// semantics are the same as those of @c memory_input_stream. @n
+    ///
+    /// Views returned by this stream point into a read-only mapping;
+    /// writing through them is undefined behaviour. They are valid
+    /// as long as the stream is alive and was not moved from. @n
+    ///
+    /// @ingroup    streams
+    ///
+    class mmap_input_stream final
+        : public input_stream
+        , public random_access_source
+        , public non_copyable
+    {
+    private:
+
+        byte*           m_data = nullptr;
+        int64_t         m_length = 0;
+        int64_t         m_position = 0;
+
+    public:
+
+        ///
+        /// @brief      Initialize stream by mapping a physical file.
+        ///
+        /// @param      path       Path to the file which should be mapped.
+        /// @param      options    Mapping options.
+        ///
+        explicit mmap_input_stream(std::string_view path, mmap_options options = {});
+
+        ~mmap_input_stream() override;
+
+        mmap_input_stream(mmap_input_stream&& other) noexcept;
+        mmap_input_stream& operator=(mmap_input_stream&& other) noexcept;
+
+        [[nodiscard]] weak_buffer view() const noexcept;
+        [[nodiscard]] weak_buffer view(int64_t offset, int64_t size) const;
+
+        void advise(mmap_advice advice);
+        void advise(mmap_advice advice, int64_t offset, int64_t size);
+
+        /// @brief      Borrow bytes straight from the mapping, see @c consumable_source.
+        [[nodiscard]] byte* try_consume(std::size_t size) noexcept;
+
+        //* Implementation of base_stream.
+        //* ========================================
+
+        int64_t position() override;
+        int64_t length() override;
+        void seek_begin(int64_t offset) override;
+        void seek_current(int64_t offset) override;
+        void seek_end(int64_t offset) override;
+
+        //* Implementation of input_stream.
+        //* ========================================
+
+        int64_t read_bytes(weak_buffer output) override;
+        std::optional<weak_buffer> try_read_view(std::size_t size) override;
+
+        //* Implementation of random_access_source.
+        //* ========================================
+
+        [[nodiscard]] int64_t size() const override;
+        int64_t read_at(int64_t offset, weak_buffer output) const override;
+        [[nodiscard]] std::optional<weak_buffer> view_at(int64_t offset, std::size_t size) const override;
+
+    private:
+
+        void do_unmap() noexcept;
+
+    };
+
+
+    inline byte*
+    mmap_input_stream::try_consume(std::size_t size) noexcept
+    {
+        if (static_cast<std::size_t>(m_length - m_position) < size)
+        {
+            return nullptr;
+        }
+
+        const auto data = m_data + m_position;
+        m_position += static_cast<int64_t>(size);
+        return data;
+    }
+
+}
+
+#endif //REIO_MMAP_STREAMS_HPP
@@ -0,0 +1,112 @@
+#ifndef REIO_PARALLEL_READER_HPP
+#define REIO_PARALLEL_READER_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#endif
+
+#include "../allocators.hpp"
+#include "../asserts.hpp"
+#include "../types.hpp"
+#include "../buffers/owning_buffer.hpp"
+#include "../buffers/weak_buffer.hpp"
+#include "./random_access.hpp"
+
+
+namespace reio
+{
+
+    static constexpr std::size_t k_default_parallel_chunk_size = 4u * 1024u * 1024u;
+
+
+    ///
+    /// @brief      Options for @c parallel_reader.
+    ///
+    struct parallel_read_options final
+    {
+        std::size_t     m_chunk_size = k_default_parallel_chunk_size;   //< Number of bytes read by a worker at once.
+        std::size_t     m_concurrency = 0u;                             //< Number of workers, @c 0 for one per hardware thread.
+    };
+
+
+    ///
+    /// @brief      Reader which splits a range of a @c random_access_source into chunks,
+    ///             and reads them concurrently on a pool of worker threads.
+    ///
+    /// Every completed chunk is handed to a callback together with its offset. Sources which
+    /// can lend views (e.g. @c mmap_input_stream) are not copied at all, others (e.g. @c fd_input_stream)
+    /// are read into a per-worker buffer of @c m_chunk_size bytes, so the chunk is only valid until
+    /// the callback returns. @n
+    ///
+    /// Callbacks are called from worker threads, concurrently and in no particular order.
+    /// If either the source or a callback throws, remaining chunks are skipped, and the first
+    /// exception is rethrown by @c read. @n
+    ///
+    /// Workers are started once and reused by every @c read call; a single reader
+    /// must not be used by multiple threads at once. The source is not owned, and the allocator
+    /// (used for worker buffers) must be thread-safe.
+    ///
+    /// @ingroup    streams
+    ///
+    class parallel_reader final : public non_copyable
+    {
+    public:
+
+        using chunk_callback = std::function<void(int64_t offset, weak_buffer chunk)>;
+
+    private:
+
+        const random_access_source*     m_source;
+        parallel_read_options           m_options;
+        base_allocator*                 m_allocator;
+        std::vector<std::thread>        m_workers;
+
+        std::mutex                      m_mutex;
+        std::condition_variable         m_wake;
+        std::condition_variable         m_done;
+        uint64_t                        m_generation;
+        std::size_t                     m_busy_workers;
+        bool                            m_stopping;
+
+        const chunk_callback*           m_callback;
+        int64_t                         m_range_begin;
+        int64_t                         m_range_end;
+        std::atomic<int64_t>            m_next_chunk;
+        std::atomic<int64_t>            m_delivered;
+        std::atomic<bool>               m_failed;
+        std::exception_ptr              m_error;
+
+    public:
+
+        explicit parallel_reader(const random_access_source* source,
+                                 parallel_read_options options = {},
+                                 base_allocator* alloc = default_allocator::get_default());
+        ~parallel_reader() noexcept;
+
+        [[nodiscard]] const random_access_source* source() const noexcept;
+        [[nodiscard]] const parallel_read_options& options() const noexcept;
+        [[nodiscard]] std::size_t concurrency() const noexcept;
+
+        int64_t read(int64_t offset, int64_t size, const chunk_callback& callback);
+        int64_t read_all(const chunk_callback& callback);
+
+    private:
+
+        void worker_main();
+        void stop_workers() noexcept;
+        void read_chunks(owning_buffer& scratch);
+        int64_t read_chunk(owning_buffer& scratch, int64_t offset, std::size_t size);
+    };
+
+}
+
+#endif //REIO_PARALLEL_READER_HPP
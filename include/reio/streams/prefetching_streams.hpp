@@ -0,0 +1,156 @@
+#ifndef REIO_PREFETCHING_STREAMS_HPP
+#define REIO_PREFETCHING_STREAMS_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#endif
+
+#include "../allocators.hpp"
+#include "../asserts.hpp"
+#include "../types.hpp"
+#include "../buffers/owning_buffer.hpp"
+#include "../buffers/weak_buffer.hpp"
+#include "./streams.hpp"
+
+
+namespace reio
+{
+
+    /// @brief Default size (in bytes) of every slot of prefetching streams.
+    static constexpr std::size_t k_default_prefetch_slot_size = 256u * 1024u;
+
+    /// @brief Default number of slots of prefetching streams (triple-buffering).
+    static constexpr std::size_t k_default_prefetch_slot_count = 3u;
+
+
+    ///
+    /// @brief      Decorator for @c input_stream which reads ahead on a background thread.
+    ///
+    /// A worker thread keeps filling a ring of fixed-size slots from the wrapped stream,
+    /// while the consumer reads from the oldest filled slot; so parsing one block overlaps
+    /// with reading the next ones, and memory use is bounded by the ring size. @n
+    ///
+    /// Seeks within the current slot only move the cursor. Other seeks wait for
+    /// the in-flight read (if any), seek the wrapped stream, and drop all prefetched slots.
+    /// Failures of the wrapped stream are rethrown by the read which reaches them. @n
+    ///
+    /// The wrapped stream is not owned, must outlive the decorator, and mustn't be used
+    /// directly while the decorator is alive, since it's read from another thread.
+    /// The decorator itself is not thread-safe, like other streams.
+    ///
+    /// @ingroup    streams
+    ///
+    class prefetching_input_stream final
+        : public input_stream
+        , public non_copyable
+    {
+    private:
+
+        input_stream*               m_source;
+        owning_buffer               m_storage;
+        std::size_t                 m_slot_size;
+        std::vector<std::size_t>    m_slot_lengths;
+
+        // consumer-only state
+        int64_t                     m_position;         //< Position of the next byte to read.
+        std::size_t                 m_cursor;           //< Offset of the next byte to read within the head slot.
+        std::size_t                 m_head_length;      //< Number of valid bytes in the head slot, if it's acquired.
+        bool                        m_has_head;
+
+        // state shared with the worker
+        std::mutex                  m_mutex;
+        std::condition_variable     m_wake;             //< Signalled when the worker has something to do.
+        std::condition_variable     m_changed;          //< Signalled when the worker filled a slot or went idle.
+        std::size_t                 m_head;             //< Index of the oldest filled slot.
+        std::size_t                 m_ready;            //< Number of filled slots.
+        int64_t                     m_fill_position;    //< Position of the wrapped stream.
+        bool                        m_reading;
+        bool                        m_eof;
+        bool                        m_stopping;
+        std::exception_ptr          m_error;
+
+        std::thread                 m_worker;
+
+    public:
+
+        ///
+        /// @brief      Initialize stream by wrapping another input stream, and start prefetching.
+        ///
+        /// @param      source        Stream to read from; its current position becomes the initial one.
+        /// @param      slot_size     Size (in bytes) of every slot, i.e. of reads done by the worker.
+        /// @param      slot_count    Number of slots in the ring, at least 2.
+        /// @param      alloc         Allocator which should be used for the ring.
+        ///
+        explicit prefetching_input_stream(input_stream* source,
+                                          std::size_t slot_size = k_default_prefetch_slot_size,
+                                          std::size_t slot_count = k_default_prefetch_slot_count,
+                                          base_allocator* alloc = default_allocator::get_default());
+
+        ~prefetching_input_stream() override;
+
+        [[nodiscard]] input_stream* source() const noexcept;
+        [[nodiscard]] std::size_t slot_size() const noexcept;
+        [[nodiscard]] std::size_t slot_count() const noexcept;
+
+        /// @brief      Borrow bytes from the head slot, without waiting for the worker; see @c consumable_source.
+        [[nodiscard]] byte* try_consume(std::size_t size) noexcept;
+
+        //* Implementation of base_stream.
+        //* ========================================
+
+        int64_t position() override;
+        int64_t length() override;
+        void seek_begin(int64_t offset) override;
+        void seek_current(int64_t offset) override;
+        void seek_end(int64_t offset) override;
+
+        //* Implementation of input_stream.
+        //* ========================================
+
+        int64_t read_bytes(weak_buffer output) override;
+        int64_t read_byte() override;
+
+    private:
+
+        [[nodiscard]] byte* slot_data(std::size_t index) const noexcept;
+        [[nodiscard]] bool try_seek_within(int64_t target) noexcept;
+        [[nodiscard]] std::unique_lock<std::mutex> pause();
+        void restart(int64_t position) noexcept;
+
+        bool acquire_head(bool report = true);
+        void release_head();
+        void worker_main();
+
+    };
+
+
+    inline byte*
+    prefetching_input_stream::try_consume(std::size_t size) noexcept
+    {
+        if (!m_has_head || m_head_length - m_cursor < size)
+        {
+            return nullptr;
+        }
+
+        const auto data = slot_data(m_head) + m_cursor;
+        m_cursor += size;
+        m_position += static_cast<int64_t>(size);
+        return data;
+    }
+
+    inline byte*
+    prefetching_input_stream::slot_data(std::size_t index) const noexcept
+    {
+        return m_storage.data() + index * m_slot_size;
+    }
+
+}
+
+#endif //REIO_PREFETCHING_STREAMS_HPP
@@ -0,0 +1,118 @@
+#ifndef REIO_RANDOM_ACCESS_HPP
+#define REIO_RANDOM_ACCESS_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <optional>
+
+#endif
+
+#include "../asserts.hpp"
+#include "../types.hpp"
+#include "../buffers/weak_buffer.hpp"
+#include "./streams.hpp"
+
+
+namespace reio
+{
+
+    ///
+    /// @brief      Interface for data sources which can be read at any offset
+    ///             without a shared cursor.
+    ///
+    /// Implementations must allow concurrent @c read_at and @c view_at calls
+    /// from multiple threads, as long as the source itself isn't modified
+    /// (moved, seeked or refreshed don't count as reads) at the same time. @n
+    ///
+    /// Use @c cursor_input_stream to read a source sequentially; every thread
+    /// can have its own cursor over the same source.
+    ///
+    class random_access_source
+    {
+    public:
+
+        virtual ~random_access_source() noexcept = default;
+
+        ///
+        /// @brief      Get the total number of bytes which can be read.
+        /// @return     Size of the source (in bytes).
+        ///
+        [[nodiscard]] virtual int64_t size() const = 0;
+
+        ///
+        /// @brief      Get up to a certain number of bytes at an offset, without moving any cursor.
+        ///
+        /// @param      offset          Offset of the first byte to read; may be past the end.
+        /// @param      output          View of memory to read into; defines the number of bytes to read.
+        /// @throw      io_exception    If @c offset is negative, or @c output is empty.
+        ///
+        /// @return     Number of bytes successfully read, @c 0 past the end.
+        ///
+        virtual int64_t read_at(int64_t offset, weak_buffer output) const = 0;
+
+        ///
+        /// @brief      Borrow up to a certain number of bytes at an offset without copying them.
+        ///
+        /// Only sources which keep their data in memory can serve this.
+        /// By default, nothing is borrowed.
+        ///
+        /// @param      offset    Offset of the first byte to borrow.
+        /// @param      size      Number of bytes to borrow.
+        /// @return     View of up to @c size bytes, or @c std::nullopt if the source can't provide views.
+        ///
+        [[nodiscard]] virtual std::optional<weak_buffer> view_at(int64_t offset, std::size_t size) const;
+    };
+
+
+    ///
+    /// @brief      Implementation of @c input_stream reading sequentially
+    ///             from a @c random_access_source.
+    ///
+    /// A lightweight cursor: it only holds a pointer to the source and a position,
+    /// so any number of them (e.g. one per worker thread) can read the same source
+    /// concurrently. Seek semantics are the same as those of @c memory_input_stream. @n
+    ///
+    /// The source is not owned, and must outlive the cursor.
+    ///
+    /// @ingroup    streams
+    ///
+    class cursor_input_stream final
+        : public input_stream
+    {
+    private:
+
+        const random_access_source*     m_source;
+        int64_t                         m_position;
+
+    public:
+
+        ///
+        /// @brief      Initialize a cursor over a source.
+        ///
+        /// @param      source    Source to read from.
+        /// @param      start     Initial position of the cursor.
+        ///
+        explicit cursor_input_stream(const random_access_source* source, int64_t start = 0);
+
+        [[nodiscard]] const random_access_source* source() const noexcept;
+
+        //* Implementation of base_stream.
+        //* ========================================
+
+        int64_t position() override;
+        int64_t length() override;
+        void seek_begin(int64_t offset) override;
+        void seek_current(int64_t offset) override;
+        void seek_end(int64_t offset) override;
+
+        //* Implementation of input_stream.
+        //* ========================================
+
+        int64_t read_bytes(weak_buffer output) override;
+        std::optional<weak_buffer> try_read_view(std::size_t size) override;
+    };
+
+}
+
+#endif //REIO_RANDOM_ACCESS_HPP
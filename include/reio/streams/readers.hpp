@@ -0,0 +1,212 @@
+#ifndef REIO_READERS_HPP
+#define REIO_READERS_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <concepts>
+#include <cstring>
+
+#endif
+
+#include "../asserts.hpp"
+#include "../types.hpp"
+#include "../buffers/weak_buffer.hpp"
+#include "./streams.hpp"
+
+
+namespace reio
+{
+
+    /// @brief Input stream type which can be wrapped by @c basic_reader.
+    template<typename S>
+    concept reader_source = std::derived_from<S, input_stream>;
+
+    ///
+    /// @brief      Input stream type which can lend small blocks of bytes through @c try_consume.
+    ///
+    /// @c try_consume(size) borrows exactly @c size bytes if they are immediately available,
+    /// and advances the stream's cursor past them. Otherwise it returns @c nullptr and leaves
+    /// the cursor alone, so the caller can fall back to @c read_bytes. It has to be defined
+    /// inline, so that @c basic_reader can fold small reads into straight-line code.
+    ///
+    template<typename S>
+    concept consumable_source = reader_source<S> && requires(S& source, std::size_t size)
+    {
+        { source.try_consume(size) } noexcept -> std::same_as<byte*>;
+    };
+
+
+    ///
+    /// @brief      Statically-typed front-end for reading from a concrete input stream.
+    ///
+    /// Exposes the same reading API as @c input_stream, but resolves calls at compile time.
+    /// With a @c final stream type, fallback @c read_bytes calls are devirtualized, and
+    /// with a @c consumable_source, reads which fit into the source's storage don't call into
+    /// the stream at all, letting the compiler fold bounds checks and byte swaps into
+    /// straight-line code. @n
+    ///
+    /// @c basic_reader<input_stream> (aka @c reader) works with any stream,
+    /// through virtual calls. @n
+    ///
+    /// The reader shares its cursor with the stream, and doesn't own it.
+    ///
+    /// @tparam     Source    Concrete stream type, e.g. @c memory_input_stream or @c buffered_input_stream.
+    ///
+    /// @ingroup    streams
+    ///
+    template<reader_source Source>
+    class basic_reader final
+    {
+    public:
+
+        using source_type = Source;
+
+    private:
+
+        Source* m_source;
+
+    public:
+
+        explicit basic_reader(Source& source) noexcept
+            : m_source{ &source } {}
+
+        [[nodiscard]] Source& source() const noexcept { return *m_source; }
+
+        int64_t read_bytes(weak_buffer output);
+        int64_t read_byte();
+        void read_bytes_or_fail(weak_buffer output);
+
+        template<numeric_type T, std::endian E = std::endian::native>
+        bool read_numeric(T& out);
+
+        template<numeric_type T, std::endian E = std::endian::native>
+        T read_numeric_or_fail();
+
+    };
+
+    /// @brief Type-erased reader which works with any @c input_stream.
+    using reader = basic_reader<input_stream>;
+
+
+    ///
+    /// @brief      Get up to a certain number of bytes from the source and advance its cursor.
+    /// @param      output    View of memory to read into; defines the number of bytes to read.
+    /// @return     Number of bytes successfully read.
+    ///
+    template<reader_source Source>
+    int64_t
+    basic_reader<Source>::read_bytes(weak_buffer output)
+    {
+        REIO_ASSERT(output.data() != nullptr, "can't read from input streams into nullptr");
+        REIO_ASSERT(output.length() > 0, "can't read zero bytes from input streams");
+
+        if constexpr (consumable_source<Source>)
+        {
+            if (const auto data = m_source->try_consume(output.length()))
+            {
+                std::memcpy(output.data(), data, output.length());
+                return static_cast<int64_t>(output.length());
+            }
+        }
+
+        return m_source->read_bytes(output);
+    }
+
+    ///
+    /// @brief      Get a single byte from the source and advance its cursor.
+    /// @return     Byte value on success, @c -1 on failure.
+    ///
+    template<reader_source Source>
+    int64_t
+    basic_reader<Source>::read_byte()
+    {
+        if constexpr (consumable_source<Source>)
+        {
+            if (const auto data = m_source->try_consume(1u))
+            {
+                return static_cast<int64_t>(*data);
+            }
+        }
+
+        return m_source->read_byte();
+    }
+
+    ///
+    /// @brief      Get a fixed number of bytes, and hard-fail if not enough is available.
+    /// @param      output          View of memory to read into; defines the number of bytes to read.
+    /// @throw      io_exception    If there isn't enough bytes.
+    ///
+    template<reader_source Source>
+    void
+    basic_reader<Source>::read_bytes_or_fail(weak_buffer output)
+    {
+        [[maybe_unused]] const auto read = read_bytes(output);
+        [[maybe_unused]] const auto expected = static_cast<int64_t>(output.length());
+        REIO_ASSERT(read == expected, "failed to read required number of bytes");
+    }
+
+    ///
+    /// @brief      Read a numeric value from the source, doing endianness conversion if needed.
+    /// @tparam     T       Type of the numeric value to read.
+    /// @tparam     E       Endianness which was used to encode the value.
+    /// @param      out     Value reference which should receive the read number.
+    /// @return     Whether a sufficient number of bytes was read.
+    ///
+    template<reader_source Source>
+    template<numeric_type T, std::endian E>
+    bool
+    basic_reader<Source>::read_numeric(T& out)
+    {
+        if constexpr (consumable_source<Source>)
+        {
+            if (const auto data = m_source->try_consume(sizeof(T)))
+            {
+                std::memcpy(&out, data, sizeof(T));
+
+                if constexpr (E != std::endian::native)
+                {
+                    out = bswap(out);
+                }
+
+                return true;
+            }
+        }
+
+        // the source is of a concrete type, so this still avoids a virtual call for final streams
+        const auto view = weak_buffer{ reinterpret_cast<byte*>(&out), sizeof(T) };
+        if (m_source->read_bytes(view) != sizeof(T))
+        {
+            return false;
+        }
+
+        if constexpr (E != std::endian::native)
+        {
+            out = bswap(out);
+        }
+
+        return true;
+    }
+
+    ///
+    /// @brief      Read a numeric value from the source, doing endianness conversion if needed.
+    /// @tparam     T               Type of the numeric value to read.
+    /// @tparam     E               Endianness which was used to encode the value.
+    /// @throws     io_exception    If there isn't enough bytes.
+    /// @return     Value of a requested type.
+    ///
+    template<reader_source Source>
+    template<numeric_type T, std::endian E>
+    T
+    basic_reader<Source>::read_numeric_or_fail()
+    {
+        auto value = T{ 0u };
+        [[maybe_unused]] const auto success = read_numeric<T, E>(value);
+
+        REIO_ASSERT(success, "failed to read enough bytes for a numeric value");
+        return value;
+    }
+
+}
+
+#endif //REIO_READERS_HPP
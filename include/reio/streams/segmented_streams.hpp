@@ -0,0 +1,96 @@
+#ifndef REIO_SEGMENTED_STREAMS_HPP
+#define REIO_SEGMENTED_STREAMS_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <vector>
+
+#endif
+
+#include "../allocators.hpp"
+#include "../asserts.hpp"
+#include "../types.hpp"
+#include "../buffers/owning_buffer.hpp"
+#include "../buffers/weak_buffer.hpp"
+#include "./streams.hpp"
+
+
+namespace reio
+{
+
+    /// @brief Default size (in bytes) of every segment of a segmented stream.
+    static constexpr std::size_t k_default_segment_size = 64u * 1024u;
+
+
+    ///
+    /// @brief      Implementation of @c output_stream which stores data
+    ///             in a list of fixed-size segments.
+    ///
+    /// Unlike @c memory_output_stream, growing never reallocates or copies
+    /// what was already written: a new segment is simply appended. Seeking and
+    /// overwriting work across segment boundaries, with the same semantics
+    /// as those of @c memory_output_stream. @n
+    ///
+    /// The result can be consumed without copying through @c segments
+    /// (e.g. for vectored output), or joined into one buffer with @c flatten. @n
+    ///
+    /// @ingroup    streams
+    ///
+    class segmented_output_stream final
+        : public output_stream
+        , public non_copyable
+    {
+    private:
+
+        base_allocator*     m_allocator;
+        std::size_t         m_segment_size;
+        std::vector<byte*>  m_segments;
+        int64_t             m_length;
+        int64_t             m_position;
+
+    public:
+
+        ///
+        /// @brief      Initialize empty stream.
+        ///
+        /// @param      segment_size    Size (in bytes) of every segment.
+        /// @param      alloc           Allocator which should be used for segments.
+        ///
+        explicit segmented_output_stream(std::size_t segment_size = k_default_segment_size,
+                                         base_allocator* alloc = default_allocator::get_default());
+
+        ~segmented_output_stream() override;
+
+        segmented_output_stream(segmented_output_stream&& other) noexcept;
+        segmented_output_stream& operator=(segmented_output_stream&& other) noexcept;
+
+        [[nodiscard]] std::size_t segment_size() const noexcept;
+        [[nodiscard]] std::size_t segment_count() const noexcept;
+        [[nodiscard]] std::vector<weak_buffer> segments() const;
+        [[nodiscard]] owning_buffer flatten(base_allocator* alloc = default_allocator::get_default()) const;
+
+        void clear() noexcept;
+
+        //* Implementation of base_stream.
+        //* ========================================
+
+        int64_t position() override;
+        int64_t length() override;
+        void seek_begin(int64_t offset) override;
+        void seek_current(int64_t offset) override;
+        void seek_end(int64_t offset) override;
+
+        //* Implementation of output_stream.
+        //* ========================================
+
+        int64_t write_bytes(weak_buffer input) override;
+
+    private:
+
+        void release_segments() noexcept;
+    };
+
+}
+
+#endif //REIO_SEGMENTED_STREAMS_HPP
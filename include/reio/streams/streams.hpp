@@ -1,8 +1,19 @@
 #ifndef REIO_STREAMS_HPP
 #define REIO_STREAMS_HPP
 
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <array>
+#include <optional>
+#include <span>
+
+#endif
+
 #include "../asserts.hpp"
+#include "../byteswap.hpp"
 #include "../types.hpp"
+#include "../buffers/owning_buffer.hpp"
 #include "../buffers/weak_buffer.hpp"
 
 
@@ -60,6 +71,46 @@ namespace reio
         ///
         void read_bytes_or_fail(weak_buffer output);
 
+        ///
+        /// @brief      Fill a sequence of buffers with consecutive bytes from the data source,
+        ///             and advance internal cursor.
+        ///
+        /// By default, it is implemented as a loop over @c read_bytes which stops at the first
+        /// short read, while file-backed streams map it onto a single vectored read. Empty
+        /// buffers are skipped.
+        ///
+        /// @param      outputs    Views of memory to read into, in order.
+        /// @return     Total number of bytes successfully read.
+        ///
+        virtual int64_t read_bytes_scatter(std::span<const weak_buffer> outputs);
+
+        ///
+        /// @brief      Borrow up to a certain number of bytes from the data source without copying them,
+        ///             and advance internal cursor.
+        ///
+        /// Only streams which keep their data in memory can serve this, by returning
+        /// a view straight into their storage; the view stays valid for as long
+        /// as that storage does. By default, nothing is borrowed.
+        ///
+        /// @param      size    Number of bytes to borrow.
+        /// @return     View of up to @c size bytes, or @c std::nullopt if the stream can't provide views
+        ///             (in which case the cursor isn't moved).
+        ///
+        virtual std::optional<weak_buffer> try_read_view(std::size_t size);
+
+        ///
+        /// @brief      Get a view of up to a certain number of bytes, copying only if the stream can't lend them.
+        ///
+        /// Falls back to reading into @c scratch (which is reallocated if it's too small)
+        /// when @c try_read_view can't be served, so the result is only valid until
+        /// @c scratch is modified.
+        ///
+        /// @param      size       Number of bytes to read.
+        /// @param      scratch    Buffer to copy bytes into if they can't be borrowed.
+        /// @return     View of up to @c size bytes.
+        ///
+        weak_buffer read_view(std::size_t size, owning_buffer& scratch);
+
         ///
         /// @brief      Read a numeric value from stream, doing endianness conversion if needed.
         /// @tparam     T       Type of the numeric value to read.
@@ -107,6 +158,58 @@ namespace reio
             REIO_ASSERT(success, "failed to read enough bytes for a numeric value");
             return value;
         }
+
+        ///
+        /// @brief      Read an array of numeric values from stream with a single bulk read,
+        ///             doing endianness conversion for the whole array afterwards if needed.
+        ///
+        /// @tparam     T       Type of the numeric values to read.
+        /// @tparam     E       Endianness which was used to encode the values.
+        /// @param      out     Span which should receive the read numbers; defines their count.
+        ///
+        /// @return     Whether a sufficient number of bytes was read (if not, contents of @c out are unspecified).
+        ///
+        template<numeric_type T, std::endian E = std::endian::native>
+        bool read_numeric_array(std::span<T> out)
+        {
+            if (out.empty())
+            {
+                return true;
+            }
+
+            const auto view = weak_buffer{ reinterpret_cast<byte*>(out.data()), out.size_bytes() };
+            const auto read = read_bytes(view);
+
+            if (read != static_cast<int64_t>(out.size_bytes()))
+            {
+                return false;
+            }
+
+            if constexpr (E != std::endian::native)
+            {
+                bswap_range(out);
+            }
+
+            return true;
+        }
+
+        ///
+        /// @brief      Read an array of numeric values from stream, doing endianness conversion if needed.
+        ///
+        /// An alternative (wrapper) for @c read_numeric_array which can be used
+        /// when you can't be bothered to do manual error checking.
+        ///
+        /// @tparam     T               Type of the numeric values to read.
+        /// @tparam     E               Endianness which was used to encode the values.
+        /// @param      out             Span which should receive the read numbers; defines their count.
+        /// @throws     io_exception    If there isn't enough bytes.
+        ///
+        template<numeric_type T, std::endian E = std::endian::native>
+        void read_numeric_array_or_fail(std::span<T> out)
+        {
+            [[maybe_unused]] const auto success = read_numeric_array<T, E>(out);
+            REIO_ASSERT(success, "failed to read enough bytes for a numeric array");
+        }
     };
 
 
@@ -145,6 +248,19 @@ namespace reio
         ///
         void write_bytes_or_fail(weak_buffer input);
 
+        ///
+        /// @brief      Put a sequence of buffers into the underlying data sink one after another,
+        ///             and advance internal cursor.
+        ///
+        /// By default, it is implemented as a loop over @c write_bytes which stops at the first
+        /// short write, while file-backed streams map it onto a single vectored write. Empty
+        /// buffers are skipped.
+        ///
+        /// @param      inputs    Views of memory to write, in order.
+        /// @return     Total number of bytes successfully written.
+        ///
+        virtual int64_t write_bytes_gather(std::span<const weak_buffer> inputs);
+
         ///
         /// @brief      Write a numeric value onto stream, doing endianness conversion if needed.
         ///
@@ -185,6 +301,73 @@ namespace reio
             REIO_ASSERT(success, "failed to write enough bytes for a numeric type");
         }
 
+        ///
+        /// @brief      Write an array of numeric values onto stream, doing endianness conversion if needed.
+        ///
+        /// Values in native endianness are written with a single bulk write. Otherwise,
+        /// they are converted with @c bswap_range in fixed-size blocks on the stack,
+        /// and each block is written at once.
+        ///
+        /// @tparam     T         Type of the numeric values to write.
+        /// @tparam     E         Endianness which is expected to be used to decode the values.
+        /// @param      values    Written numbers.
+        ///
+        /// @return     Whether all values were written onto stream in full.
+        ///
+        template<numeric_type T, std::endian E = std::endian::native>
+        bool write_numeric_array(std::span<const T> values)
+        {
+            if (values.empty())
+            {
+                return true;
+            }
+
+            if constexpr (E == std::endian::native)
+            {
+                // const_cast is safe, since weak_buffer is only read from
+                const auto buffer = weak_buffer{ reinterpret_cast<byte*>(const_cast<T*>(values.data())), values.size_bytes() };
+                const auto written = write_bytes(buffer);
+
+                return written == static_cast<int64_t>(values.size_bytes());
+            }
+            else
+            {
+                constexpr auto block_size = std::size_t{ 4096u } / sizeof(T);
+                std::array<T, block_size> block;
+
+                for (std::size_t offset = 0u; offset < values.size(); offset += block_size)
+                {
+                    const auto count = std::min(block_size, values.size() - offset);
+                    bswap_range<T>(values.subspan(offset, count), std::span<T>{ block }.first(count));
+
+                    const auto buffer = weak_buffer{ reinterpret_cast<byte*>(block.data()), count * sizeof(T) };
+                    if (write_bytes(buffer) != static_cast<int64_t>(count * sizeof(T)))
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+        }
+
+        ///
+        /// @brief      Write an array of numeric values onto stream, doing endianness conversion if needed.
+        ///
+        /// Alternative to (wrapper of) the @c output_stream::write_numeric_array
+        /// which spares the programmer from necessity to do manual error checking.
+        ///
+        /// @tparam     T         Type of the numeric values to write.
+        /// @tparam     E         Endianness which is expected to be used to decode the values.
+        /// @param      values    Written numbers.
+        ///
+        template<numeric_type T, std::endian E = std::endian::native>
+        void write_numeric_array_or_fail(std::span<const T> values)
+        {
+            [[maybe_unused]] const auto success = write_numeric_array<T, E>(values);
+            REIO_ASSERT(success, "failed to write enough bytes for a numeric array");
+        }
+
     };
 
 }
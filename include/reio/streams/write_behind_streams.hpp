@@ -0,0 +1,146 @@
+#ifndef REIO_WRITE_BEHIND_STREAMS_HPP
+#define REIO_WRITE_BEHIND_STREAMS_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#endif
+
+#include "../allocators.hpp"
+#include "../asserts.hpp"
+#include "../types.hpp"
+#include "../buffers/owning_buffer.hpp"
+#include "../buffers/weak_buffer.hpp"
+#include "./streams.hpp"
+
+
+namespace reio
+{
+
+    /// @brief Default size (in bytes) of every slot of write-behind streams.
+    static constexpr std::size_t k_default_write_behind_slot_size = 256u * 1024u;
+
+    /// @brief Default number of slots of write-behind streams (one being filled, the rest queued).
+    static constexpr std::size_t k_default_write_behind_slot_count = 4u;
+
+
+    ///
+    /// @brief      Decorator for @c output_stream which writes on a background thread.
+    ///
+    /// Bytes are accumulated in a slot; once it fills up, it's queued for a worker thread
+    /// which writes it into the wrapped stream, and the producer continues with a free slot.
+    /// The producer only blocks when all slots are queued, so memory use is bounded by
+    /// the number of slots. @n
+    ///
+    /// Seeks which land within the current slot only move the cursor. Other seeks (and @c length)
+    /// wait until the queue is written, and then go through the wrapped stream, so back-patching
+    /// headers still works, at the cost of a flush. @n
+    ///
+    /// Failures of the worker are rethrown by the next write, seek or @c flush.
+    /// Slots queued after a failure are dropped. The pending slot is flushed on destruction,
+    /// but call @c flush explicitly to be notified of failures. @n
+    ///
+    /// The wrapped stream is not owned, must outlive the decorator, and mustn't be used
+    /// directly while the decorator is alive, since it's written from another thread.
+    /// The decorator itself is not thread-safe, like other streams.
+    ///
+    /// @ingroup    streams
+    ///
+    class write_behind_output_stream final
+        : public output_stream
+        , public non_copyable
+    {
+    private:
+
+        struct queued_slot final
+        {
+            std::size_t     m_index;
+            std::size_t     m_length;
+        };
+
+        output_stream*              m_sink;
+        owning_buffer               m_storage;
+        std::size_t                 m_slot_size;
+        std::size_t                 m_slot_count;
+
+        // producer-only state
+        std::size_t                 m_slot;             //< Index of the slot being filled.
+        int64_t                     m_window_start;     //< Position of the slot's first byte in the wrapped stream.
+        std::size_t                 m_window_length;    //< Number of pending bytes in the slot.
+        std::size_t                 m_cursor;           //< Offset of the next byte to write within the slot.
+
+        // state shared with the worker
+        std::mutex                  m_mutex;
+        std::condition_variable     m_wake;             //< Signalled when a slot is queued, or the worker should stop.
+        std::condition_variable     m_changed;          //< Signalled when the worker wrote a slot.
+        std::vector<queued_slot>    m_queue;            //< Ring of slots waiting to be written.
+        std::size_t                 m_queue_head;
+        std::size_t                 m_queue_count;
+        std::vector<std::size_t>    m_free;
+        bool                        m_writing;
+        bool                        m_stopping;
+        std::atomic<bool>           m_failed;
+        std::exception_ptr          m_error;
+
+        std::thread                 m_worker;
+
+    public:
+
+        ///
+        /// @brief      Initialize stream by wrapping another output stream, and start the writer.
+        ///
+        /// @param      sink          Stream to write to; its current position becomes the initial one.
+        /// @param      slot_size     Size (in bytes) of every slot, i.e. of writes done by the worker.
+        /// @param      slot_count    Number of slots, at least 2.
+        /// @param      alloc         Allocator which should be used for the slots.
+        ///
+        explicit write_behind_output_stream(output_stream* sink,
+                                            std::size_t slot_size = k_default_write_behind_slot_size,
+                                            std::size_t slot_count = k_default_write_behind_slot_count,
+                                            base_allocator* alloc = default_allocator::get_default());
+
+        ~write_behind_output_stream() override;
+
+        [[nodiscard]] output_stream* sink() const noexcept;
+        [[nodiscard]] std::size_t slot_size() const noexcept;
+        [[nodiscard]] std::size_t slot_count() const noexcept;
+
+        void flush();
+
+        //* Implementation of base_stream.
+        //* ========================================
+
+        int64_t position() override;
+        int64_t length() override;
+        void seek_begin(int64_t offset) override;
+        void seek_current(int64_t offset) override;
+        void seek_end(int64_t offset) override;
+
+        //* Implementation of output_stream.
+        //* ========================================
+
+        int64_t write_bytes(weak_buffer input) override;
+        bool write_byte(byte value) override;
+
+    private:
+
+        [[nodiscard]] byte* slot_data(std::size_t index) const noexcept;
+        [[nodiscard]] bool try_seek_within(int64_t target) noexcept;
+
+        void check_failure();
+        void submit();
+        void drain();
+        void worker_main();
+
+    };
+
+}
+
+#endif //REIO_WRITE_BEHIND_STREAMS_HPP
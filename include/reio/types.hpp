@@ -90,6 +90,10 @@ namespace reio
     #error Probably unsupported compiler | _REIO_FUNC_ |
 #endif
 
+#if defined(__unix__) || defined(__APPLE__)
+    #define REIO_PLATFORM_POSIX     1  // mmap, file descriptors, pread/pwrite etc. are available
+#endif
+
 
     ///
     /// Minimum information required to uniquely identify
@@ -0,0 +1,82 @@
+#ifndef REIO_VM_ALLOCATOR_HPP
+#define REIO_VM_ALLOCATOR_HPP
+
+
+#ifndef REIO_OPTION_NO_INCLUDES
+
+#include <cstddef>
+
+#endif
+
+#include "./allocators.hpp"
+#include "./asserts.hpp"
+#include "./types.hpp"
+
+#ifndef REIO_PLATFORM_POSIX
+    #error Virtual memory allocator is only implemented for POSIX platforms
+#endif
+
+
+namespace reio
+{
+
+    static constexpr std::size_t k_default_vm_threshold = 1024u * 1024u;
+
+
+    ///
+    /// @brief      Options for @c vm_allocator.
+    ///
+    struct vm_options final
+    {
+        std::size_t     m_threshold = k_default_vm_threshold;   //< Smallest size which gets its own mapping.
+        bool            m_huge_pages = false;                   //< Ask for transparent huge pages (MADV_HUGEPAGE, Linux only).
+    };
+
+
+    ///
+    /// @brief      Allocator which backs large blocks with anonymous memory mappings.
+    ///
+    /// Blocks of at least @c m_threshold bytes get their own private mapping, smaller ones
+    /// are passed to a fallback allocator. Growing a mapped block remaps its pages
+    /// (@c mremap on Linux) instead of copying them, so a huge @c owning_buffer
+    /// or @c memory_output_stream doubles its capacity without ever holding two copies. @n
+    ///
+    /// Mapping failures are reported as NULL allocations. Thread-safe as long
+    /// as the fallback allocator is.
+    ///
+    class vm_allocator final
+        : public base_allocator
+        , public non_copyable
+    {
+    private:
+
+        vm_options          m_options;
+        base_allocator*     m_fallback;
+        std::size_t         m_page_size;
+
+    public:
+
+        explicit vm_allocator(vm_options options = {},
+                              base_allocator* fallback = default_allocator::get_default());
+
+        byte* allocate(std::size_t size, std::size_t alignment = k_default_alignment) override;
+        void deallocate(byte* ptr, std::size_t size, std::size_t alignment = k_default_alignment) override;
+        bool try_expand(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment = k_default_alignment) override;
+        byte* reallocate(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t preserved,
+                         std::size_t alignment = k_default_alignment) override;
+
+        [[nodiscard]] const vm_options& options() const noexcept;
+        [[nodiscard]] std::size_t page_size() const noexcept;
+        [[nodiscard]] bool is_mapped(std::size_t size, std::size_t alignment = k_default_alignment) const noexcept;
+
+    private:
+
+        [[nodiscard]] std::size_t page_round(std::size_t size) const noexcept;
+        byte* map(std::size_t size) const noexcept;
+
+    };
+
+}
+
+
+#endif //REIO_VM_ALLOCATOR_HPP
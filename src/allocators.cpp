@@ -1,16 +1,585 @@
 #include "reio/allocators.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
 namespace reio
 {
 
-    byte* default_allocator::allocate(std::size_t size)
+    /// Granularity of arena allocation sizes, and the alignment of chunks.
+    static constexpr std::size_t k_arena_alignment = k_default_alignment;
+
+    static constexpr std::size_t DoAlignUp(std::size_t size, std::size_t alignment = k_arena_alignment) noexcept
+    {
+        return (size + alignment - 1u) & ~(alignment - 1u);
+    }
+
+    static byte* DoAlignPointer(byte* ptr, std::size_t alignment) noexcept
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        return ptr + (DoAlignUp(address, alignment) - address);
+    }
+
+    static constexpr bool DoIsOverAligned(std::size_t alignment) noexcept
+    {
+        return alignment > k_default_alignment;
+    }
+
+
+    ///
+    /// @brief      Resize a block without moving it, if the allocator supports it.
+    ///
+    /// The default implementation never does.
+    ///
+    /// @param      ptr         Pointer returned by @c allocate.
+    /// @param      old_size    Current size of the block.
+    /// @param      new_size    Requested size of the block.
+    /// @param      alignment   Alignment which was passed to @c allocate.
+    /// @return     Whether the block now has @c new_size bytes, at the same address.
+    ///
+    bool
+    base_allocator::try_expand(byte*, std::size_t, std::size_t, std::size_t)
+    {
+        return false;
+    }
+
+    ///
+    /// @brief      Resize a block, moving it if it can't be resized in place.
+    ///
+    /// The default implementation tries @c try_expand, and otherwise allocates
+    /// a new block, copies the preserved bytes and deallocates the old one.
+    ///
+    /// @param      ptr         Pointer returned by @c allocate.
+    /// @param      old_size    Current size of the block.
+    /// @param      new_size    Requested size of the block.
+    /// @param      preserved   Number of leading bytes which must be kept, at most @c old_size.
+    /// @param      alignment   Alignment which was passed to @c allocate, and which the block keeps.
+    /// @return     Pointer to the resized block, or NULL if the allocation failed
+    ///             (in which case the old block is left untouched).
+    ///
+    byte*
+    base_allocator::reallocate(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t preserved,
+                               std::size_t alignment)
+    {
+        if (try_expand(ptr, old_size, new_size, alignment))
+        {
+            return ptr;
+        }
+
+        const auto allocation = allocate(new_size, alignment);
+        if (allocation != nullptr)
+        {
+            if (preserved > 0u)
+            {
+                std::memcpy(allocation, ptr, std::min({ preserved, old_size, new_size }));
+            }
+            deallocate(ptr, old_size, alignment);
+        }
+        return allocation;
+    }
+
+
+    byte* default_allocator::allocate(std::size_t size, std::size_t alignment)
+    {
+        // malloc can't be asked for more, and free can't release aligned operator new
+        return DoIsOverAligned(alignment)
+            ? static_cast<byte*>(::operator new(size, std::align_val_t{ alignment }, std::nothrow))
+            : static_cast<byte*>(std::malloc(size));
+    }
+
+    void default_allocator::deallocate(byte *ptr, std::size_t, std::size_t alignment)
+    {
+        if (DoIsOverAligned(alignment))
+        {
+            ::operator delete(ptr, std::align_val_t{ alignment });
+        }
+        else
+        {
+            std::free(ptr);
+        }
+    }
+
+    byte* default_allocator::reallocate(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t preserved,
+                                        std::size_t alignment)
+    {
+        if (DoIsOverAligned(alignment))
+        {
+            // realloc would only keep the default alignment
+            return base_allocator::reallocate(ptr, old_size, new_size, preserved, alignment);
+        }
+
+        // lets the C runtime grow in place, or remap pages of big blocks
+        return static_cast<byte*>(std::realloc(ptr, new_size));
+    }
+
+
+    ///
+    /// @brief      Initialize the allocator.
+    /// @param      alignment       Alignment of every block, a power of two.
+    /// @throw      io_exception    If @c alignment is not a power of two.
+    ///
+    aligned_allocator::aligned_allocator(std::size_t alignment)
+        : m_alignment{ std::max(alignment, alignof(std::max_align_t)) }
+    {
+        REIO_ASSERT(std::has_single_bit(alignment), "allocator alignment must be a power of two");
+    }
+
+    ///
+    /// @brief      Allocate an aligned block.
+    /// @param      size        Number of bytes to allocate.
+    /// @param      alignment   Minimum alignment, raised to the allocator's own one.
+    /// @return     Pointer to the block, or NULL if the allocation failed.
+    ///
+    byte*
+    aligned_allocator::allocate(std::size_t size, std::size_t alignment)
+    {
+        return static_cast<byte*>(::operator new(size, std::align_val_t{ std::max(alignment, m_alignment) }, std::nothrow));
+    }
+
+    void
+    aligned_allocator::deallocate(byte* ptr, std::size_t, std::size_t alignment)
+    {
+        ::operator delete(ptr, std::align_val_t{ std::max(alignment, m_alignment) });
+    }
+
+    ///
+    /// @brief      Get the alignment of blocks returned by @c allocate.
+    /// @return     Alignment (in bytes), at least @c alignof(std::max_align_t).
+    ///
+    std::size_t
+    aligned_allocator::alignment() const noexcept
+    {
+        return m_alignment;
+    }
+
+
+    ///
+    /// Header placed at the start of every arena chunk, chunks form a singly-linked list
+    /// with the chunk currently used for bumping at its head.
+    ///
+    struct arena_allocator::chunk_header
+    {
+        chunk_header*   m_next;
+        std::size_t     m_size;
+
+        [[nodiscard]] byte* begin() noexcept { return reinterpret_cast<byte*>(this) + DoAlignUp(sizeof(chunk_header)); }
+        [[nodiscard]] byte* end() noexcept { return begin() + m_size; }
+    };
+
+
+    ///
+    /// @brief      Initialize the arena, without allocating anything yet.
+    /// @param      chunk_size      Usable size of regular chunks.
+    /// @param      upstream        Allocator which provides chunks.
+    /// @throw      io_exception    If @c chunk_size is zero, or @c upstream is NULL.
+    ///
+    arena_allocator::arena_allocator(std::size_t chunk_size, base_allocator* upstream)
+        : m_upstream{ upstream }, m_chunk_size{ DoAlignUp(chunk_size) }
+        , m_chunks{ nullptr }, m_cursor{ nullptr }
+        , m_chunk_end{ nullptr }, m_last{ nullptr }
+        , m_last_cursor{ nullptr }, m_stats{}
+    {
+        REIO_ASSERT(chunk_size > 0u, "arena chunk size must be positive");
+        REIO_ASSERT(upstream != nullptr, "arena can't have null upstream allocator");
+    }
+
+    arena_allocator::~arena_allocator() noexcept
+    {
+        release();
+    }
+
+    ///
+    /// @brief      Carve a block out of the current chunk, adding a new chunk if it doesn't fit.
+    /// @param      size            Number of bytes to allocate.
+    /// @param      alignment       Alignment of the block; the cursor is padded up to it.
+    /// @throw      io_exception    If the upstream allocator fails.
+    /// @return     Pointer to the aligned block.
+    ///
+    byte*
+    arena_allocator::allocate(std::size_t size, std::size_t alignment)
+    {
+        const auto aligned_size = DoAlignUp(size);
+
+        // chunks are only aligned by default, so over-aligned blocks may need padding in front
+        const auto padding = DoIsOverAligned(alignment) ? alignment - k_arena_alignment : 0u;
+        auto start = m_cursor != nullptr ? DoAlignPointer(m_cursor, std::max(alignment, k_arena_alignment)) : nullptr;
+
+        if (start == nullptr || start > m_chunk_end || static_cast<std::size_t>(m_chunk_end - start) < aligned_size)
+        {
+            if (aligned_size + padding > m_chunk_size)
+            {
+                // dedicated chunk, linked behind the current one so bumping continues there
+                const auto chunk = add_chunk(aligned_size + padding);
+                if (m_chunks != nullptr)
+                {
+                    chunk->m_next = m_chunks->m_next;
+                    m_chunks->m_next = chunk;
+                }
+                else
+                {
+                    m_chunks = chunk;
+                }
+
+                m_last = nullptr;
+                m_stats.m_bytes_allocated += aligned_size + padding;
+                m_stats.m_allocation_count++;
+                return DoAlignPointer(chunk->begin(), std::max(alignment, k_arena_alignment));
+            }
+
+            const auto chunk = add_chunk(m_chunk_size);
+            chunk->m_next = m_chunks;
+            m_chunks = chunk;
+            m_cursor = chunk->begin();
+            m_chunk_end = chunk->end();
+            start = DoAlignPointer(m_cursor, std::max(alignment, k_arena_alignment));
+        }
+
+        m_stats.m_bytes_allocated += static_cast<std::size_t>(start - m_cursor) + aligned_size;
+        m_stats.m_allocation_count++;
+
+        m_last = start;
+        m_last_cursor = m_cursor;
+        m_cursor = start + aligned_size;
+        return m_last;
+    }
+
+    ///
+    /// @brief      Roll back the most recent allocation, ignore any other.
+    /// @param      ptr     Pointer returned by @c allocate.
+    ///
+    void
+    arena_allocator::deallocate(byte* ptr, std::size_t, std::size_t)
+    {
+        if (ptr != nullptr && ptr == m_last)
+        {
+            // padding in front of over-aligned blocks was counted too, so it's rolled back along
+            m_stats.m_bytes_allocated -= static_cast<std::size_t>(m_cursor - m_last_cursor);
+            m_cursor = m_last_cursor;
+            m_last = m_last_cursor = nullptr;
+        }
+    }
+
+    ///
+    /// @brief      Resize the most recent allocation, while it fits into the current chunk.
+    /// @param      ptr         Pointer returned by @c allocate.
+    /// @param      old_size    Current size of the block.
+    /// @param      new_size    Requested size of the block.
+    /// @return     Whether the block was resized in place.
+    ///
+    bool
+    arena_allocator::try_expand(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t)
+    {
+        if (ptr == nullptr || ptr != m_last)
+        {
+            return false;
+        }
+
+        const auto aligned_size = DoAlignUp(new_size);
+        if (static_cast<std::size_t>(m_chunk_end - m_last) < aligned_size)
+        {
+            return false;
+        }
+
+        m_stats.m_bytes_allocated += aligned_size;
+        m_stats.m_bytes_allocated -= DoAlignUp(old_size);
+        m_cursor = m_last + aligned_size;
+        return true;
+    }
+
+    ///
+    /// @brief      Free all allocations at once.
+    ///
+    /// The most recent regular chunk is kept for reuse, the rest are returned upstream.
+    ///
+    void
+    arena_allocator::reset() noexcept
+    {
+        chunk_header* kept = nullptr;
+        if (m_chunks != nullptr && m_chunks->m_size == m_chunk_size)
+        {
+            kept = m_chunks;
+            m_chunks = m_chunks->m_next;
+        }
+
+        release();
+
+        if (kept != nullptr)
+        {
+            kept->m_next = nullptr;
+            m_chunks = kept;
+            m_cursor = kept->begin();
+            m_chunk_end = kept->end();
+
+            m_stats.m_chunk_count = 1u;
+            m_stats.m_bytes_reserved = kept->m_size;
+        }
+    }
+
+    ///
+    /// @brief      Free all allocations and return every chunk to the upstream allocator.
+    ///
+    void
+    arena_allocator::release() noexcept
+    {
+        while (m_chunks != nullptr)
+        {
+            const auto next = m_chunks->m_next;
+            m_upstream->deallocate(reinterpret_cast<byte*>(m_chunks), DoAlignUp(sizeof(chunk_header)) + m_chunks->m_size);
+            m_chunks = next;
+        }
+
+        m_cursor = m_chunk_end = m_last = m_last_cursor = nullptr;
+        m_stats = {};
+    }
+
+    ///
+    /// @brief      Get the usable size of regular chunks.
+    /// @return     Chunk size (in bytes), rounded up to the allocation alignment.
+    ///
+    std::size_t
+    arena_allocator::chunk_size() const noexcept
+    {
+        return m_chunk_size;
+    }
+
+    ///
+    /// @brief      Get memory usage counters.
+    /// @return     Copy of the current counters.
+    ///
+    arena_stats
+    arena_allocator::stats() const noexcept
+    {
+        return m_stats;
+    }
+
+    arena_allocator::chunk_header*
+    arena_allocator::add_chunk(std::size_t size)
+    {
+        const auto allocation = m_upstream->allocate(DoAlignUp(sizeof(chunk_header)) + size);
+        REIO_ASSERT(allocation != nullptr, "arena failed to allocate a chunk");
+
+        m_stats.m_chunk_count++;
+        m_stats.m_bytes_reserved += size;
+        return ::new (allocation) chunk_header{ nullptr, size };
+    }
+
+
+
+    ///
+    /// Header placed at the start of every pool slab, only used to free slabs on destruction.
+    ///
+    struct pool_allocator::slab_header
+    {
+        slab_header*    m_next;
+        std::size_t     m_size;
+    };
+
+    ///
+    /// Free list node, stored within the unused block itself.
+    ///
+    struct pool_allocator::free_block
+    {
+        free_block*     m_next;
+    };
+
+    static std::size_t DoPoolClassIndex(std::size_t size) noexcept
+    {
+        return size <= k_pool_min_block_size
+            ? 0u
+            : static_cast<std::size_t>(std::bit_width(size - 1u) - std::bit_width(k_pool_min_block_size - 1u));
+    }
+
+
+    ///
+    /// @brief      Initialize the pool, without allocating anything yet.
+    /// @param      max_block_size  Biggest size which is still pooled, rounded up to a power of two.
+    /// @param      slab_size       Size of slabs requested from @c upstream, at least one maximum block.
+    /// @param      upstream        Allocator which provides slabs and bigger blocks.
+    /// @throw      io_exception    If sizes are out of range, or @c upstream is NULL.
+    ///
+    pool_allocator::pool_allocator(std::size_t max_block_size, std::size_t slab_size, base_allocator* upstream)
+        : m_upstream{ upstream }
+        , m_max_block_size{ std::bit_ceil(std::max(max_block_size, k_pool_min_block_size)) }
+        , m_slab_size{ DoAlignUp(slab_size) }
+        , m_class_count{ DoPoolClassIndex(m_max_block_size) + 1u }
+        , m_free_lists{}, m_slabs{ nullptr }
+        , m_stats{}
+    {
+        REIO_ASSERT(upstream != nullptr, "pool can't have null upstream allocator");
+        REIO_ASSERT(m_class_count <= k_max_classes, "pool max block size is too big");
+        REIO_ASSERT(m_slab_size >= m_max_block_size, "pool slab must fit at least one block");
+    }
+
+    pool_allocator::~pool_allocator() noexcept
     {
-        return ::new byte[size];
+        while (m_slabs != nullptr)
+        {
+            const auto next = m_slabs->m_next;
+            m_upstream->deallocate(reinterpret_cast<byte*>(m_slabs), m_slabs->m_size);
+            m_slabs = next;
+        }
     }
 
-    void default_allocator::deallocate(byte *ptr)
+    ///
+    /// @brief      Take a block from the matching free list, or pass big or over-aligned requests upstream.
+    /// @param      size            Number of bytes to allocate.
+    /// @param      alignment       Alignment of the block.
+    /// @throw      io_exception    If the upstream allocator fails.
+    /// @return     Pointer to the aligned block.
+    ///
+    byte*
+    pool_allocator::allocate(std::size_t size, std::size_t alignment)
     {
-        ::delete [] ptr;
+        if (is_upstream(size, alignment))
+        {
+            const auto allocation = m_upstream->allocate(size, alignment);
+            if (allocation != nullptr)
+            {
+                m_stats.m_upstream_allocations++;
+            }
+            return allocation;
+        }
+
+        const auto index = DoPoolClassIndex(size);
+        if (m_free_lists[index] == nullptr)
+        {
+            refill(index);
+        }
+
+        const auto block = m_free_lists[index];
+        m_free_lists[index] = block->m_next;
+
+        m_stats.m_blocks_in_use++;
+        return reinterpret_cast<byte*>(block);
+    }
+
+    ///
+    /// @brief      Return a block to its free list, or pass big or over-aligned blocks upstream.
+    /// @param      ptr         Pointer returned by @c allocate.
+    /// @param      size        Size which was passed to @c allocate.
+    /// @param      alignment   Alignment which was passed to @c allocate.
+    ///
+    void
+    pool_allocator::deallocate(byte* ptr, std::size_t size, std::size_t alignment)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        if (is_upstream(size, alignment))
+        {
+            m_upstream->deallocate(ptr, size, alignment);
+            m_stats.m_upstream_allocations--;
+            return;
+        }
+
+        const auto index = DoPoolClassIndex(size);
+        m_free_lists[index] = ::new (ptr) free_block{ m_free_lists[index] };
+        m_stats.m_blocks_in_use--;
+    }
+
+    ///
+    /// @brief      Resize a block in place, if it stays within the same size class.
+    /// @param      ptr         Pointer returned by @c allocate.
+    /// @param      old_size    Current size of the block.
+    /// @param      new_size    Requested size of the block.
+    /// @param      alignment   Alignment which was passed to @c allocate.
+    /// @return     Whether the block now has @c new_size bytes, at the same address.
+    ///
+    bool
+    pool_allocator::try_expand(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment)
+    {
+        if (is_upstream(old_size, alignment) && is_upstream(new_size, alignment))
+        {
+            return m_upstream->try_expand(ptr, old_size, new_size, alignment);
+        }
+
+        return !is_upstream(old_size, alignment) && !is_upstream(new_size, alignment)
+            && DoPoolClassIndex(old_size) == DoPoolClassIndex(new_size);
+    }
+
+    ///
+    /// @brief      Resize a block, letting the upstream allocator handle blocks too big for the pool.
+    /// @param      ptr         Pointer returned by @c allocate.
+    /// @param      old_size    Current size of the block.
+    /// @param      new_size    Requested size of the block.
+    /// @param      preserved   Number of leading bytes which must be kept.
+    /// @param      alignment   Alignment which was passed to @c allocate.
+    /// @return     Pointer to the resized block, or NULL if the allocation failed.
+    ///
+    byte*
+    pool_allocator::reallocate(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t preserved,
+                               std::size_t alignment)
+    {
+        if (is_upstream(old_size, alignment) && is_upstream(new_size, alignment))
+        {
+            return m_upstream->reallocate(ptr, old_size, new_size, preserved, alignment);
+        }
+
+        return base_allocator::reallocate(ptr, old_size, new_size, preserved, alignment);
+    }
+
+    ///
+    /// @brief      Get the biggest size which is still served from the pool.
+    /// @return     Size (in bytes) of the largest size class.
+    ///
+    std::size_t
+    pool_allocator::max_block_size() const noexcept
+    {
+        return m_max_block_size;
+    }
+
+    ///
+    /// @brief      Get the size of a block which would be used for a request.
+    /// @param      size    Number of bytes to allocate.
+    /// @return     Size (in bytes) of the matching size class.
+    ///
+    std::size_t
+    pool_allocator::block_size_for(std::size_t size) noexcept
+    {
+        return std::max(std::bit_ceil(size), k_pool_min_block_size);
+    }
+
+    ///
+    /// @brief      Get memory usage counters.
+    /// @return     Copy of the current counters.
+    ///
+    pool_stats
+    pool_allocator::stats() const noexcept
+    {
+        return m_stats;
+    }
+
+    bool
+    pool_allocator::is_upstream(std::size_t size, std::size_t alignment) const noexcept
+    {
+        // pooled blocks are only as aligned as the slabs they're carved from
+        return size > m_max_block_size || DoIsOverAligned(alignment);
+    }
+
+    void
+    pool_allocator::refill(std::size_t class_index)
+    {
+        const auto block_size = k_pool_min_block_size << class_index;
+        const auto header_size = DoAlignUp(sizeof(slab_header));
+
+        const auto allocation = m_upstream->allocate(header_size + m_slab_size);
+        REIO_ASSERT(allocation != nullptr, "pool failed to allocate a slab");
+
+        m_slabs = ::new (allocation) slab_header{ m_slabs, header_size + m_slab_size };
+        m_stats.m_slab_count++;
+        m_stats.m_bytes_reserved += m_slab_size;
+
+        // link blocks back to front, so they are handed out in address order
+        const auto blocks = allocation + header_size;
+        for (auto offset = m_slab_size - m_slab_size % block_size; offset > 0u; offset -= block_size)
+        {
+            m_free_lists[class_index] = ::new (blocks + offset - block_size) free_block{ m_free_lists[class_index] };
+        }
     }
 
 }
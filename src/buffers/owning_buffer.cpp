@@ -1,5 +1,8 @@
 #include "reio/buffers/owning_buffer.hpp"
 
+#include <algorithm>
+#include <bit>
+
 namespace reio
 {
 
@@ -12,6 +15,7 @@ namespace reio
         : m_begin{ nullptr }, m_end{ nullptr }
         , m_alloc_end{ nullptr }, m_allocator{ alloc }
         , m_growth{ k_default_growth_factor }
+        , m_alignment{ k_default_alignment }
     {
         REIO_ASSERT(alloc != nullptr, "owning buffer can't have null allocator");
     }
@@ -24,14 +28,35 @@ namespace reio
     ///
     owning_buffer::owning_buffer(owning_buffer::size_type capacity,
                                  owning_buffer::alloc_ptr alloc)
+        : owning_buffer{ capacity, std::align_val_t{ k_default_alignment }, alloc }
+    {
+
+    }
+
+    ///
+    /// @brief      Initialize the buffer by preallocating some aligned memory.
+    ///
+    /// The alignment is kept whenever the buffer grows, e.g. for aligned SIMD loads,
+    /// @c O_DIRECT transfers, or casting contents to over-aligned structures.
+    ///
+    /// @param      capacity        Amount of memory to preallocate, may be zero.
+    /// @param      alignment       Alignment of the memory, a power of two.
+    /// @param      alloc           Optional custom allocator to use.
+    /// @throw      io_exception    If @c alloc is NULL, @c alignment isn't a power of two, or preallocation fails.
+    ///
+    owning_buffer::owning_buffer(owning_buffer::size_type capacity,
+                                 std::align_val_t alignment,
+                                 owning_buffer::alloc_ptr alloc)
         : m_allocator{ alloc }
         , m_growth{ k_default_growth_factor }
+        , m_alignment{ std::max(static_cast<size_type>(alignment), k_default_alignment) }
     {
         REIO_ASSERT(alloc != nullptr, "owning buffer can't have null allocator");
+        REIO_ASSERT(std::has_single_bit(static_cast<size_type>(alignment)), "owning buffer alignment must be a power of two");
 
         pointer allocation = nullptr;
         if (capacity > 0u) {
-            allocation = alloc->allocate(capacity);
+            allocation = alloc->allocate(capacity, m_alignment);
             REIO_ASSERT(allocation != nullptr, "owning buffer failed to pre-allocate");
         }
 
@@ -71,7 +96,7 @@ namespace reio
     owning_buffer::~owning_buffer() noexcept
     {
         if (m_alloc_end != nullptr) {
-            m_allocator->deallocate(m_begin);
+            m_allocator->deallocate(m_begin, capacity(), m_alignment);
         }
     }
 
@@ -81,6 +106,7 @@ namespace reio
         , m_alloc_end{ std::exchange(other.m_alloc_end, nullptr) }
         , m_allocator{ std::exchange(other.m_allocator, nullptr) }
         , m_growth{ std::exchange(other.m_growth, k_default_growth_factor) }
+        , m_alignment{ std::exchange(other.m_alignment, k_default_alignment) }
     {
 
     }
@@ -89,45 +115,20 @@ namespace reio
     owning_buffer::operator=(owning_buffer &&other) noexcept
     {
         if (this != &other) {
+            if (m_alloc_end != nullptr) {
+                m_allocator->deallocate(m_begin, capacity(), m_alignment);
+            }
+
             m_begin = std::exchange(other.m_begin, nullptr);
             m_end = std::exchange(other.m_end, nullptr);
             m_alloc_end = std::exchange(other.m_alloc_end, nullptr);
             m_allocator = std::exchange(other.m_allocator, nullptr);
             m_growth = std::exchange(other.m_growth, k_default_growth_factor);
+            m_alignment = std::exchange(other.m_alignment, k_default_alignment);
         }
         return *this;
     }
 
-    ///
-    /// @brief      Get pointer to the start of the owned bytes.
-    /// @return     Pointer to the start of the owned memory block.
-    ///
-    owning_buffer::pointer
-    owning_buffer::data() const noexcept
-    {
-        return m_begin;
-    }
-
-    ///
-    /// @brief      Get number of the owned bytes in use.
-    /// @return     Length (in bytes) of the used memory block.
-    ///
-    owning_buffer::size_type
-    owning_buffer::length() const noexcept
-    {
-        return static_cast<size_type>(m_end - m_begin);
-    }
-
-    ///
-    /// @brief      Get number of the owned bytes in total (possibly beyond what's currently used).
-    /// @return     Length (in bytes) of the owned memory block.
-    ///
-    owning_buffer::size_type
-    owning_buffer::capacity() const noexcept
-    {
-        return static_cast<size_type>(m_alloc_end - m_begin);
-    }
-
     ///
     /// @brief      Get the expansion policy.
     /// @return     Current expansion policy.
@@ -148,6 +149,16 @@ namespace reio
         return m_allocator;
     }
 
+    ///
+    /// @brief      Get the alignment of the memory.
+    /// @return     Alignment which is kept across reallocations.
+    ///
+    owning_buffer::size_type
+    owning_buffer::alignment() const noexcept
+    {
+        return m_alignment;
+    }
+
     ///
     /// @brief      Update the buffer expansion policy.
     /// @param      factor    New buffer expansion policy.
@@ -183,28 +194,6 @@ namespace reio
         m_end = m_alloc_end;
     }
 
-    ///
-    /// @brief      Get a byte within the buffer, without bounds check.
-    /// @param      index    Index of the byte.
-    /// @return     Non-const reference to a byte at @c index.
-    ///
-    owning_buffer::reference
-    owning_buffer::operator[](owning_buffer::size_type index) noexcept
-    {
-        return m_begin[index];
-    }
-
-    ///
-    /// @brief      Get a byte within the buffer, without bounds check.
-    /// @param      index    Index of the byte.
-    /// @return     Copy of a byte at @c index.
-    ///
-    owning_buffer::value_type
-    owning_buffer::operator[](owning_buffer::size_type index) const noexcept
-    {
-        return m_begin[index];
-    }
-
     ///
     /// @brief      Get a byte within the buffer, doing a bounds check.
     ///
@@ -295,16 +284,6 @@ namespace reio
         return { m_begin + offset, my_length - offset };
     }
 
-    owning_buffer::iterator owning_buffer::begin() noexcept { return m_begin; }
-    owning_buffer::iterator owning_buffer::end() noexcept { return m_end; }
-    owning_buffer::const_iterator owning_buffer::begin() const noexcept { return m_begin; }
-    owning_buffer::const_iterator owning_buffer::end() const noexcept { return m_end; }
-    owning_buffer::const_iterator owning_buffer::cbegin() const noexcept { return m_begin; }
-    owning_buffer::const_iterator owning_buffer::cend() const noexcept { return m_end; }
-    owning_buffer::iterator owning_buffer::alloc_end() noexcept { return m_alloc_end; }
-    owning_buffer::const_iterator owning_buffer::alloc_end() const noexcept { return m_alloc_end; }
-    owning_buffer::const_iterator owning_buffer::alloc_cend() const noexcept { return m_alloc_end; }
-
     ///
     /// @brief      Remove a sequence from the buffer.
     ///
@@ -364,12 +343,12 @@ namespace reio
         const auto old_capacity = capacity();
 
         if (new_capacity > old_capacity) {
-            pointer allocation = m_allocator->allocate(new_capacity);
+            // only the used part is preserved, and the allocator may grow the block in place
+            pointer allocation = m_alloc_end != nullptr
+                ? m_allocator->reallocate(m_begin, old_capacity, new_capacity, old_length, m_alignment)
+                : m_allocator->allocate(new_capacity, m_alignment);
             REIO_ASSERT(allocation != nullptr, "owning buffer failed to reallocate");
 
-            std::copy(m_begin, m_end, allocation);
-            m_allocator->deallocate(m_begin);
-
             m_begin = allocation;
             m_end = allocation + old_length;
             m_alloc_end = allocation + new_capacity;
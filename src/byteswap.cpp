@@ -0,0 +1,310 @@
+#include "reio/byteswap.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define REIO_BSWAP_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #define REIO_BSWAP_NEON
+    #include <arm_neon.h>
+#endif
+
+#if defined(REIO_BSWAP_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define REIO_TARGET(ISA)    __attribute__((target(ISA)))
+#else
+    #define REIO_TARGET(ISA)
+#endif
+
+
+namespace reio
+{
+
+    using bswap_func = void (*)(const byte* source, byte* dest, std::size_t count) noexcept;
+
+    struct bswap_table final
+    {
+        bswap_kernel    m_kernel;
+        bswap_func      m_swap16;
+        bswap_func      m_swap32;
+        bswap_func      m_swap64;
+    };
+
+
+    //* Scalar kernels, also used for tails of vector kernels.
+    //* ========================================
+
+    template<typename U>
+    void DoSwapScalar(const byte* source, byte* dest, std::size_t count) noexcept
+    {
+        // memcpy instead of casts, since blocks are not required to be aligned
+        for (std::size_t i = 0u; i < count; i++)
+        {
+            U value;
+            std::memcpy(&value, source + i * sizeof(U), sizeof(U));
+            value = bswap(value);
+            std::memcpy(dest + i * sizeof(U), &value, sizeof(U));
+        }
+    }
+
+    static constexpr bswap_table k_scalar_table{
+        bswap_kernel::scalar,
+        &DoSwapScalar<uint16_t>,
+        &DoSwapScalar<uint32_t>,
+        &DoSwapScalar<uint64_t>
+    };
+
+
+#ifdef REIO_BSWAP_X86
+
+    //* x86 kernels, built for their own ISA regardless of global compiler flags.
+    //* ========================================
+
+    ///
+    /// Byte shuffle which reverses every element of size @c W within a 128-bit lane,
+    /// repeated twice to cover 256-bit registers (whose shuffles are done per lane).
+    ///
+    template<std::size_t W>
+    static constexpr auto k_shuffle_mask = []() {
+        std::array<char, 32u> mask{};
+        for (std::size_t i = 0u; i < mask.size(); i++)
+        {
+            const auto lane_index = i % 16u;
+            mask[i] = static_cast<char>(lane_index - lane_index % W + (W - 1u - lane_index % W));
+        }
+        return mask;
+    }();
+
+    template<typename U>
+    REIO_TARGET("ssse3")
+    void DoSwapSsse3(const byte* source, byte* dest, std::size_t count) noexcept
+    {
+        const auto shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(k_shuffle_mask<sizeof(U)>.data()));
+        const auto length = count * sizeof(U);
+
+        std::size_t offset = 0u;
+        for (; offset + 16u <= length; offset += 16u)
+        {
+            const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + offset), _mm_shuffle_epi8(v, shuffle));
+        }
+
+        DoSwapScalar<U>(source + offset, dest + offset, (length - offset) / sizeof(U));
+    }
+
+    template<typename U>
+    REIO_TARGET("avx2")
+    void DoSwapAvx2(const byte* source, byte* dest, std::size_t count) noexcept
+    {
+        const auto shuffle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k_shuffle_mask<sizeof(U)>.data()));
+        const auto length = count * sizeof(U);
+
+        std::size_t offset = 0u;
+        for (; offset + 64u <= length; offset += 64u)
+        {
+            const auto v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + offset));
+            const auto v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + offset + 32u));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + offset), _mm256_shuffle_epi8(v0, shuffle));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + offset + 32u), _mm256_shuffle_epi8(v1, shuffle));
+        }
+        for (; offset + 32u <= length; offset += 32u)
+        {
+            const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + offset));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + offset), _mm256_shuffle_epi8(v, shuffle));
+        }
+
+        DoSwapScalar<U>(source + offset, dest + offset, (length - offset) / sizeof(U));
+    }
+
+    static constexpr bswap_table k_ssse3_table{
+        bswap_kernel::ssse3,
+        &DoSwapSsse3<uint16_t>,
+        &DoSwapSsse3<uint32_t>,
+        &DoSwapSsse3<uint64_t>
+    };
+
+    static constexpr bswap_table k_avx2_table{
+        bswap_kernel::avx2,
+        &DoSwapAvx2<uint16_t>,
+        &DoSwapAvx2<uint32_t>,
+        &DoSwapAvx2<uint64_t>
+    };
+
+    static bool DoCpuSupports(bswap_kernel kernel) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        switch (kernel)
+        {
+            case bswap_kernel::ssse3:   return __builtin_cpu_supports("ssse3");
+            case bswap_kernel::avx2:    return __builtin_cpu_supports("avx2");
+            default:                    return false;
+        }
+#elif defined(_MSC_VER)
+        int info[4] = {};
+        switch (kernel)
+        {
+            case bswap_kernel::ssse3:
+            {
+                __cpuid(info, 1);
+                return (info[2] & (1 << 9)) != 0;
+            }
+            case bswap_kernel::avx2:
+            {
+                // AVX2 also requires the OS to save YMM registers (OSXSAVE + XCR0 bits)
+                __cpuid(info, 1);
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+                {
+                    return false;
+                }
+
+                __cpuidex(info, 7, 0);
+                return (info[1] & (1 << 5)) != 0;
+            }
+            default:
+            {
+                return false;
+            }
+        }
+#else
+        return false;
+#endif
+    }
+
+#endif // REIO_BSWAP_X86
+
+
+#ifdef REIO_BSWAP_NEON
+
+    //* ARM kernels, NEON is a baseline feature of AArch64.
+    //* ========================================
+
+    template<typename U>
+    void DoSwapNeon(const byte* source, byte* dest, std::size_t count) noexcept
+    {
+        const auto length = count * sizeof(U);
+
+        std::size_t offset = 0u;
+        for (; offset + 16u <= length; offset += 16u)
+        {
+            const auto v = vld1q_u8(source + offset);
+
+            if constexpr (sizeof(U) == 2u) vst1q_u8(dest + offset, vrev16q_u8(v));
+            if constexpr (sizeof(U) == 4u) vst1q_u8(dest + offset, vrev32q_u8(v));
+            if constexpr (sizeof(U) == 8u) vst1q_u8(dest + offset, vrev64q_u8(v));
+        }
+
+        DoSwapScalar<U>(source + offset, dest + offset, (length - offset) / sizeof(U));
+    }
+
+    static constexpr bswap_table k_neon_table{
+        bswap_kernel::neon,
+        &DoSwapNeon<uint16_t>,
+        &DoSwapNeon<uint32_t>,
+        &DoSwapNeon<uint64_t>
+    };
+
+#endif // REIO_BSWAP_NEON
+
+
+    //* Dispatch.
+    //* ========================================
+
+    static const bswap_table* DoFindTable(bswap_kernel kernel) noexcept
+    {
+        switch (kernel)
+        {
+            case bswap_kernel::scalar:
+                return &k_scalar_table;
+#ifdef REIO_BSWAP_X86
+            case bswap_kernel::ssse3:
+                return DoCpuSupports(kernel) ? &k_ssse3_table : nullptr;
+            case bswap_kernel::avx2:
+                return DoCpuSupports(kernel) ? &k_avx2_table : nullptr;
+#endif
+#ifdef REIO_BSWAP_NEON
+            case bswap_kernel::neon:
+                return &k_neon_table;
+#endif
+            default:
+                return nullptr;
+        }
+    }
+
+    static const bswap_table* DoDetectTable() noexcept
+    {
+        for (const auto kernel : { bswap_kernel::avx2, bswap_kernel::ssse3, bswap_kernel::neon })
+        {
+            if (const auto table = DoFindTable(kernel))
+            {
+                return table;
+            }
+        }
+        return &k_scalar_table;
+    }
+
+    static std::atomic<const bswap_table*>& DoActiveTable() noexcept
+    {
+        static std::atomic<const bswap_table*> table{ DoDetectTable() };
+        return table;
+    }
+
+
+    bswap_kernel
+    active_bswap_kernel() noexcept
+    {
+        return DoActiveTable().load(std::memory_order_relaxed)->m_kernel;
+    }
+
+    bool
+    is_bswap_kernel_supported(bswap_kernel kernel) noexcept
+    {
+        return DoFindTable(kernel) != nullptr;
+    }
+
+    bool
+    select_bswap_kernel(bswap_kernel kernel) noexcept
+    {
+        const auto table = DoFindTable(kernel);
+        if (table == nullptr)
+        {
+            return false;
+        }
+
+        DoActiveTable().store(table, std::memory_order_relaxed);
+        return true;
+    }
+
+    void
+    bswap_bytes(std::size_t width, const byte* source, byte* dest, std::size_t count)
+    {
+        const auto table = DoActiveTable().load(std::memory_order_relaxed);
+
+        switch (width)
+        {
+            case 1u:
+            {
+                if (source != dest && count > 0u)
+                {
+                    std::memcpy(dest, source, count);
+                }
+                break;
+            }
+            case 2u: table->m_swap16(source, dest, count); break;
+            case 4u: table->m_swap32(source, dest, count); break;
+            case 8u: table->m_swap64(source, dest, count); break;
+            default:
+            {
+                REIO_FAIL("unsupported element width for byte swapping", __FILE__, __LINE__, _REIO_FUNC_);
+            }
+        }
+    }
+
+}
+
+#undef REIO_TARGET
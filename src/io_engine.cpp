@@ -0,0 +1,587 @@
+#include "reio/io_engine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+    #include <sys/syscall.h>
+    #if defined(__NR_io_uring_setup) && __has_include(<linux/io_uring.h>)
+        #define REIO_IO_URING
+        #include <linux/io_uring.h>
+    #endif
+#endif
+
+
+namespace reio
+{
+
+    /// @brief Largest transfer which Linux does in a single read or write.
+    static constexpr std::size_t k_max_transfer_size = 0x7FFFF000u;
+
+
+#ifdef REIO_IO_URING
+
+    //* Raw io_uring, set up without liburing.
+    //* ========================================
+
+    struct io_engine::uring_state final
+    {
+        int             m_fd = -1;
+
+        void*           m_sq_ring = MAP_FAILED;
+        std::size_t     m_sq_ring_size = 0u;
+        void*           m_cq_ring = MAP_FAILED;
+        std::size_t     m_cq_ring_size = 0u;
+        io_uring_sqe*   m_sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        std::size_t     m_sqes_size = 0u;
+
+        unsigned*       m_sq_head = nullptr;
+        unsigned*       m_sq_tail = nullptr;
+        unsigned        m_sq_mask = 0u;
+        unsigned*       m_sq_array = nullptr;
+
+        unsigned*       m_cq_head = nullptr;
+        unsigned*       m_cq_tail = nullptr;
+        unsigned        m_cq_mask = 0u;
+        io_uring_cqe*   m_cqes = nullptr;
+    };
+
+    template<typename T>
+    static T* DoRingField(void* ring, uint32_t offset) noexcept
+    {
+        return reinterpret_cast<T*>(static_cast<byte*>(ring) + offset);
+    }
+
+    static void DoDestroyUring(io_engine::uring_state* uring) noexcept;
+
+    ///
+    /// @brief      Check whether the kernel supports all operations used by the engine.
+    ///
+    static bool DoProbeUring(int fd) noexcept
+    {
+        constexpr unsigned k_probe_ops = 256u;
+
+        alignas(io_uring_probe) byte storage[sizeof(io_uring_probe) + k_probe_ops * sizeof(io_uring_probe_op)] = {};
+        const auto probe = reinterpret_cast<io_uring_probe*>(storage);
+
+        if (::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, k_probe_ops) < 0)
+        {
+            return false;
+        }
+
+        for (const auto op : { IORING_OP_READ, IORING_OP_WRITE })
+        {
+            if (op > probe->last_op || (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0u)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ///
+    /// @brief      Create an io_uring instance and map its rings.
+    /// @return     Instance which should be destroyed with @c DoDestroyUring, or NULL if io_uring is unavailable.
+    ///
+    static io_engine::uring_state* DoSetupUring(uint32_t entries) noexcept
+    {
+        io_uring_params params{};
+        const auto fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+
+        auto uring = new (std::nothrow) io_engine::uring_state{};
+        if (uring == nullptr)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+        uring->m_fd = fd;
+
+        if (!DoProbeUring(fd))
+        {
+            DoDestroyUring(uring);
+            return nullptr;
+        }
+
+        uring->m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        uring->m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        uring->m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+        // since 5.4, both rings share a single mapping
+        const auto single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0u;
+        if (single_mmap)
+        {
+            uring->m_sq_ring_size = std::max(uring->m_sq_ring_size, uring->m_cq_ring_size);
+            uring->m_cq_ring_size = uring->m_sq_ring_size;
+        }
+
+        uring->m_sq_ring = ::mmap(nullptr, uring->m_sq_ring_size, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        uring->m_cq_ring = single_mmap
+            ? uring->m_sq_ring
+            : ::mmap(nullptr, uring->m_cq_ring_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        uring->m_sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, uring->m_sqes_size, PROT_READ | PROT_WRITE,
+                                                          MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+
+        if (uring->m_sq_ring == MAP_FAILED || uring->m_cq_ring == MAP_FAILED || uring->m_sqes == MAP_FAILED)
+        {
+            DoDestroyUring(uring);
+            return nullptr;
+        }
+
+        uring->m_sq_head = DoRingField<unsigned>(uring->m_sq_ring, params.sq_off.head);
+        uring->m_sq_tail = DoRingField<unsigned>(uring->m_sq_ring, params.sq_off.tail);
+        uring->m_sq_mask = *DoRingField<unsigned>(uring->m_sq_ring, params.sq_off.ring_mask);
+        uring->m_sq_array = DoRingField<unsigned>(uring->m_sq_ring, params.sq_off.array);
+
+        uring->m_cq_head = DoRingField<unsigned>(uring->m_cq_ring, params.cq_off.head);
+        uring->m_cq_tail = DoRingField<unsigned>(uring->m_cq_ring, params.cq_off.tail);
+        uring->m_cq_mask = *DoRingField<unsigned>(uring->m_cq_ring, params.cq_off.ring_mask);
+        uring->m_cqes = DoRingField<io_uring_cqe>(uring->m_cq_ring, params.cq_off.cqes);
+
+        return uring;
+    }
+
+    static void DoDestroyUring(io_engine::uring_state* uring) noexcept
+    {
+        if (uring == nullptr)
+        {
+            return;
+        }
+
+        if (uring->m_sqes != MAP_FAILED)
+        {
+            ::munmap(uring->m_sqes, uring->m_sqes_size);
+        }
+        if (uring->m_cq_ring != MAP_FAILED && uring->m_cq_ring != uring->m_sq_ring)
+        {
+            ::munmap(uring->m_cq_ring, uring->m_cq_ring_size);
+        }
+        if (uring->m_sq_ring != MAP_FAILED)
+        {
+            ::munmap(uring->m_sq_ring, uring->m_sq_ring_size);
+        }
+
+        ::close(uring->m_fd);
+        delete uring;
+    }
+
+#else
+
+    struct io_engine::uring_state final {};
+
+    static io_engine::uring_state* DoSetupUring([[maybe_unused]] uint32_t entries) noexcept
+    {
+        return nullptr;
+    }
+
+    static void DoDestroyUring([[maybe_unused]] io_engine::uring_state* uring) noexcept
+    {
+
+    }
+
+#endif // REIO_IO_URING
+
+
+
+    ///
+    /// @brief      Initialize an engine, setting up io_uring if it's available.
+    ///
+    /// @param      options         Queue depth and backend selection.
+    /// @param      alloc           Allocator for buffers of reads which don't have an external one.
+    /// @throw      io_exception    If queue depth is zero.
+    ///
+    io_engine::io_engine(io_engine_options options, base_allocator* alloc)
+        : m_options{ options }
+        , m_allocator{ alloc }
+        , m_backend{ io_backend::pread }
+        , m_uring{ nullptr }
+    {
+        REIO_ASSERT(options.m_queue_depth > 0u, "can't initialize I/O engine with an empty queue");
+
+        m_requests.resize(options.m_queue_depth);
+        m_free.reserve(options.m_queue_depth);
+        m_queued.reserve(options.m_queue_depth);
+
+        for (uint32_t i = options.m_queue_depth; i > 0u; i--)
+        {
+            m_free.push_back(i - 1u);
+        }
+
+        // set up last, since nothing would tear the ring down if the constructor threw afterwards
+        if (!options.m_force_fallback)
+        {
+            m_uring = DoSetupUring(options.m_queue_depth);
+            m_backend = m_uring != nullptr ? io_backend::uring : io_backend::pread;
+        }
+    }
+
+    io_engine::~io_engine() noexcept
+    {
+        // the kernel may still be writing into buffers which are about to be freed
+        if (m_uring != nullptr && in_flight() > m_completed.size())
+        {
+            try
+            {
+                std::vector<io_completion> discarded;
+                wait(discarded, in_flight());
+            }
+            catch (...)
+            {
+#ifdef _DEBUG
+                std::fputs("warning: failed to wait for requests in flight in ~io_engine", stderr);
+#endif
+            }
+        }
+
+        DoDestroyUring(m_uring);
+    }
+
+    ///
+    /// @brief      Check whether io_uring can be used by the current process.
+    /// @return     Whether the kernel provides io_uring with all required operations, and allows its use.
+    ///
+    bool
+    io_engine::is_uring_supported() noexcept
+    {
+        static const bool supported = []() {
+            const auto uring = DoSetupUring(1u);
+            DoDestroyUring(uring);
+            return uring != nullptr;
+        }();
+
+        return supported;
+    }
+
+    ///
+    /// @brief      Get the mechanism which executes requests.
+    /// @return     @c io_backend::uring if io_uring was set up, @c io_backend::pread otherwise.
+    ///
+    io_backend
+    io_engine::backend() const noexcept
+    {
+        return m_backend;
+    }
+
+    ///
+    /// @brief      Get the maximum number of requests in flight.
+    /// @return     Queue depth; submitting past it waits for a completion.
+    ///
+    uint32_t
+    io_engine::queue_depth() const noexcept
+    {
+        return m_options.m_queue_depth;
+    }
+
+    ///
+    /// @brief      Get the number of requests whose completions weren't returned by @c wait yet.
+    /// @return     Number of submitted requests which weren't waited for.
+    ///
+    std::size_t
+    io_engine::in_flight() const noexcept
+    {
+        return m_requests.size() - m_free.size() + m_completed.size();
+    }
+
+    ///
+    /// @brief      Queue a read into a buffer owned by the engine.
+    ///
+    /// @param      fd              Readable descriptor; it must stay open until the read completes.
+    /// @param      offset          Offset of the first byte to read.
+    /// @param      size            Number of bytes to read.
+    /// @param      tag             Value identifying the completion.
+    /// @throw      io_exception    If arguments are invalid, or the buffer can't be allocated.
+    ///
+    void
+    io_engine::submit_read(int fd, int64_t offset, std::size_t size, uint64_t tag)
+    {
+        REIO_ASSERT(size > 0u, "can't read zero bytes");
+
+        owning_buffer buffer{ size, m_allocator };
+        buffer.resize_to_capacity();
+        const auto target = weak_buffer{ buffer.data(), size };
+
+        submit_read(fd, offset, target, tag);
+        m_requests[m_queued.back()].m_buffer = std::move(buffer);
+    }
+
+    ///
+    /// @brief      Queue a read into an external buffer.
+    ///
+    /// @param      fd              Readable descriptor; it must stay open until the read completes.
+    /// @param      offset          Offset of the first byte to read.
+    /// @param      output          Memory to read into; it must stay alive until the read completes.
+    /// @param      tag             Value identifying the completion.
+    /// @throw      io_exception    If arguments are invalid.
+    ///
+    void
+    io_engine::submit_read(int fd, int64_t offset, weak_buffer output, uint64_t tag)
+    {
+        REIO_ASSERT(fd >= 0, "can't read from an invalid descriptor");
+        REIO_ASSERT(offset >= 0, "can't read at a negative offset");
+        REIO_ASSERT(output.data() != nullptr, "can't read into nullptr");
+        REIO_ASSERT(output.length() > 0u, "can't read zero bytes");
+
+        const auto index = acquire_slot();
+        auto& request = m_requests[index];
+
+        request.m_target = output;
+        request.m_tag = tag;
+        request.m_offset = offset;
+        request.m_fd = fd;
+        request.m_write = false;
+
+        enqueue(index);
+    }
+
+    ///
+    /// @brief      Queue a write of a buffer, which is given back on completion.
+    ///
+    /// @param      fd              Writable descriptor; it must stay open until the write completes.
+    /// @param      offset          Offset of the first byte to write.
+    /// @param      input           Bytes to write.
+    /// @param      tag             Value identifying the completion.
+    /// @throw      io_exception    If arguments are invalid.
+    ///
+    void
+    io_engine::submit_write(int fd, int64_t offset, owning_buffer input, uint64_t tag)
+    {
+        REIO_ASSERT(fd >= 0, "can't write into an invalid descriptor");
+        REIO_ASSERT(offset >= 0, "can't write at a negative offset");
+        REIO_ASSERT(input.length() > 0u, "can't write zero bytes");
+
+        const auto index = acquire_slot();
+        auto& request = m_requests[index];
+
+        request.m_target = input.view();
+        request.m_buffer = std::move(input);
+        request.m_tag = tag;
+        request.m_offset = offset;
+        request.m_fd = fd;
+        request.m_write = true;
+
+        enqueue(index);
+    }
+
+    ///
+    /// @brief      Hand all queued requests to the kernel without waiting for them.
+    ///
+    /// Called by @c wait too, so this is only needed to start requests early.
+    /// The @c pread backend executes requests in @c wait, so nothing is done here.
+    ///
+    /// @throw      io_exception    If io_uring rejected the batch.
+    /// @return     Number of requests which were handed to the kernel.
+    ///
+    std::size_t
+    io_engine::submit()
+    {
+        if (m_backend != io_backend::uring)
+        {
+            return 0u;
+        }
+
+        return submit_uring(0u);
+    }
+
+    ///
+    /// @brief      Wait for requests to complete, and collect their completions.
+    ///
+    /// Queued requests are submitted first. Afterwards, all completions which are available
+    /// are appended, so there may be more than @c min_count of them.
+    ///
+    /// @param      completions     Vector to append completions to.
+    /// @param      min_count       Number of completions to wait for; clamped to @c in_flight.
+    /// @throw      io_exception    If io_uring failed.
+    ///
+    /// @return     Number of appended completions.
+    ///
+    std::size_t
+    io_engine::wait(std::vector<io_completion>& completions, std::size_t min_count)
+    {
+        const auto initial = completions.size();
+
+        std::move(m_completed.begin(), m_completed.end(), std::back_inserter(completions));
+        m_completed.clear();
+
+        if (m_backend != io_backend::uring)
+        {
+            execute_fallback(completions);
+            return completions.size() - initial;
+        }
+
+        submit_uring(0u);
+        reap_uring(completions);
+
+        const auto outstanding = m_requests.size() - m_free.size();
+        const auto target = std::min(min_count, completions.size() - initial + outstanding);
+
+        while (completions.size() - initial < target)
+        {
+            submit_uring(static_cast<uint32_t>(target - (completions.size() - initial)));
+            reap_uring(completions);
+        }
+
+        return completions.size() - initial;
+    }
+
+    uint32_t
+    io_engine::acquire_slot()
+    {
+        // the queue is full, so some room has to be made by completing requests
+        while (m_free.empty())
+        {
+            if (m_backend == io_backend::uring)
+            {
+                submit_uring(1u);
+                reap_uring(m_completed);
+            }
+            else
+            {
+                execute_fallback(m_completed);
+            }
+        }
+
+        const auto index = m_free.back();
+        m_free.pop_back();
+        return index;
+    }
+
+    void
+    io_engine::enqueue(uint32_t index)
+    {
+        m_queued.push_back(index);
+    }
+
+    io_completion
+    io_engine::complete(uint32_t index, int64_t result)
+    {
+        auto& request = m_requests[index];
+        io_completion completion{ request.m_tag, result, std::move(request.m_buffer) };
+
+        // reads into own buffers are trimmed to the number of bytes actually read
+        if (!request.m_write && completion.m_buffer.length() > 0u)
+        {
+            const auto kept = static_cast<std::size_t>(std::max<int64_t>(result, 0));
+            completion.m_buffer.erase(completion.m_buffer.begin() + kept, completion.m_buffer.end());
+        }
+
+        request.m_buffer = owning_buffer{};
+        request.m_target = weak_buffer{};
+        m_free.push_back(index);
+
+        return completion;
+    }
+
+    std::size_t
+    io_engine::submit_uring([[maybe_unused]] uint32_t min_complete)
+    {
+#ifdef REIO_IO_URING
+        const auto uring = m_uring;
+        const auto submitted = m_queued.size();
+
+        auto tail = *uring->m_sq_tail;
+        for (const auto index : m_queued)
+        {
+            const auto& request = m_requests[index];
+            const auto sq_index = tail & uring->m_sq_mask;
+
+            auto& sqe = uring->m_sqes[sq_index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = request.m_write ? IORING_OP_WRITE : IORING_OP_READ;
+            sqe.fd = request.m_fd;
+            sqe.off = static_cast<uint64_t>(request.m_offset);
+            sqe.addr = reinterpret_cast<uint64_t>(request.m_target.data());
+            sqe.len = static_cast<uint32_t>(std::min(request.m_target.length(), k_max_transfer_size));
+            sqe.user_data = index;
+
+            uring->m_sq_array[sq_index] = sq_index;
+            tail++;
+        }
+        m_queued.clear();
+
+        // the kernel only sees new entries once the tail is published
+        std::atomic_ref{ *uring->m_sq_tail }.store(tail, std::memory_order_release);
+
+        while (true)
+        {
+            const auto head = std::atomic_ref{ *uring->m_sq_head }.load(std::memory_order_acquire);
+            const auto to_submit = tail - head;
+            const auto flags = min_complete > 0u ? IORING_ENTER_GETEVENTS : 0u;
+
+            if (to_submit == 0u && min_complete == 0u)
+            {
+                break;
+            }
+
+            const auto rc = ::syscall(__NR_io_uring_enter, uring->m_fd, to_submit, min_complete, flags, nullptr, 0);
+            if (rc < 0 && (errno == EINTR || errno == EAGAIN))
+            {
+                continue;
+            }
+
+            REIO_ASSERT(rc >= 0, "io_uring_enter failed");
+            break;
+        }
+
+        return submitted;
+#else
+        return 0u;
+#endif
+    }
+
+    void
+    io_engine::reap_uring([[maybe_unused]] std::vector<io_completion>& completions)
+    {
+#ifdef REIO_IO_URING
+        const auto uring = m_uring;
+
+        auto head = *uring->m_cq_head;
+        const auto tail = std::atomic_ref{ *uring->m_cq_tail }.load(std::memory_order_acquire);
+
+        for (; head != tail; head++)
+        {
+            const auto& cqe = uring->m_cqes[head & uring->m_cq_mask];
+            completions.push_back(complete(static_cast<uint32_t>(cqe.user_data), cqe.res));
+        }
+
+        std::atomic_ref{ *uring->m_cq_head }.store(head, std::memory_order_release);
+#endif
+    }
+
+    void
+    io_engine::execute_fallback(std::vector<io_completion>& completions)
+    {
+        for (const auto index : m_queued)
+        {
+            const auto& request = m_requests[index];
+            const auto data = request.m_target.data();
+            const auto size = std::min(request.m_target.length(), k_max_transfer_size);
+            const auto offset = static_cast<off_t>(request.m_offset);
+
+            ssize_t done;
+            do
+            {
+                done = request.m_write
+                    ? ::pwrite(request.m_fd, data, size, offset)
+                    : ::pread(request.m_fd, data, size, offset);
+            }
+            while (done < 0 && errno == EINTR);
+
+            completions.push_back(complete(index, done < 0 ? -errno : static_cast<int64_t>(done)));
+        }
+
+        m_queued.clear();
+    }
+
+}
@@ -0,0 +1,419 @@
+#include "reio/streams/async_streams.hpp"
+#include "reio/streams/fd_streams.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace reio
+{
+
+    /// @brief Engine tag of the read which wakes the loop up when worker threads complete operations.
+    static constexpr uint64_t k_wakeup_tag = 0u;
+
+    static thread_local event_loop* t_current_loop = nullptr;
+
+
+    event_loop::scope::scope(event_loop* loop) noexcept
+        : m_previous{ std::exchange(t_current_loop, loop) }
+    {
+
+    }
+
+    event_loop::scope::~scope() noexcept
+    {
+        t_current_loop = m_previous;
+    }
+
+
+    ///
+    /// @brief      Initialize a loop, and start its worker threads.
+    /// @param      options         Queue depth, number of workers, and backend selection.
+    /// @throw      io_exception    If the wake-up pipe can't be created.
+    ///
+    event_loop::event_loop(event_loop_options options)
+        : m_engine{ { .m_queue_depth = options.m_queue_depth, .m_force_fallback = options.m_force_fallback } }
+        , m_engine_ops{ 0u }
+        , m_blocking_ops{ 0u }
+        , m_wakeup{ -1, -1 }
+        , m_wakeup_armed{ false }
+        , m_wakeup_buffer{}
+        , m_stopping{ false }
+    {
+        [[maybe_unused]] const auto rc = ::pipe(m_wakeup);
+        REIO_ASSERT(rc == 0, "failed to create a wake-up pipe for event loop");
+
+        for (const auto fd : m_wakeup)
+        {
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+
+        // workers signal every completion, and mustn't block if the loop lags behind
+        ::fcntl(m_wakeup[1], F_SETFL, ::fcntl(m_wakeup[1], F_GETFL) | O_NONBLOCK);
+
+        m_workers.reserve(options.m_worker_count);
+        try
+        {
+            for (std::size_t i = 0u; i < std::max<std::size_t>(options.m_worker_count, 1u); i++)
+            {
+                m_workers.emplace_back(&event_loop::worker_main, this);
+            }
+        }
+        catch (...)
+        {
+            // the destructor doesn't run, and joinable threads would terminate the process
+            stop_workers();
+            ::close(m_wakeup[0]);
+            ::close(m_wakeup[1]);
+            throw;
+        }
+    }
+
+    event_loop::~event_loop() noexcept
+    {
+        // spawned tasks may still have reads in flight, whose buffers are freed along with their frames
+        try
+        {
+            while (m_engine_ops > 0u)
+            {
+                m_completions.clear();
+                m_engine.wait(m_completions, 1u);
+
+                for (const auto& completion : m_completions)
+                {
+                    if (completion.m_tag == k_wakeup_tag)
+                    {
+                        m_wakeup_armed = false;
+                        continue;
+                    }
+                    m_engine_ops--;
+                }
+            }
+        }
+        catch (...)
+        {
+#ifdef _DEBUG
+            std::fputs("warning: failed to wait for reads in flight in ~event_loop", stderr);
+#endif
+        }
+
+        stop_workers();
+
+        // the engine waits for its requests on destruction, so the wake-up read has to complete
+        if (m_wakeup_armed)
+        {
+            [[maybe_unused]] const auto written = ::write(m_wakeup[1], "", 1u);
+        }
+
+        ::close(m_wakeup[0]);
+        ::close(m_wakeup[1]);
+    }
+
+    ///
+    /// @brief      Get the loop which is running on the current thread.
+    /// @return     Loop whose @c run is being executed, or NULL.
+    ///
+    event_loop*
+    event_loop::current() noexcept
+    {
+        return t_current_loop;
+    }
+
+    ///
+    /// @brief      Get the engine which executes reads, e.g. to check its backend.
+    /// @return     Engine owned by the loop.
+    ///
+    const io_engine&
+    event_loop::engine() const noexcept
+    {
+        return m_engine;
+    }
+
+    ///
+    /// @brief      Hand a task over to the loop; it's started by the next @c run.
+    /// @param      detached    Task to run.
+    ///
+    void
+    event_loop::spawn(task<void> detached)
+    {
+        // the frame is owned before its handle is queued, so a failure can't leave a dangling handle
+        const auto handle = detached.handle();
+        m_tasks.push_back(std::move(detached));
+
+        try
+        {
+            m_ready.push_back(handle);
+        }
+        catch (...)
+        {
+            m_tasks.pop_back();
+            throw;
+        }
+    }
+
+    ///
+    /// @brief      Run the loop until all spawned tasks finish.
+    /// @throw      ...     First exception which escaped a spawned task.
+    ///
+    void
+    event_loop::run()
+    {
+        const scope current{ this };
+
+        while (!m_ready.empty() || has_pending())
+        {
+            step();
+        }
+        collect_tasks();
+
+        if (m_task_error)
+        {
+            std::rethrow_exception(std::exchange(m_task_error, nullptr));
+        }
+    }
+
+    ///
+    /// @brief      Start a read, which resumes the operation's coroutine once it completes.
+    ///
+    /// Reads from @c fd_input_stream go through the engine, others are run on a worker thread.
+    ///
+    /// @param      operation       State of the read, which must stay alive until it completes.
+    /// @param      stream          Stream to read from.
+    /// @param      output          View of memory to read into.
+    /// @throw      io_exception    If @c output is empty.
+    ///
+    void
+    event_loop::schedule_read(async_operation& operation, input_stream& stream, weak_buffer output)
+    {
+        REIO_ASSERT(output.data() != nullptr, "can't read from input streams into nullptr");
+        REIO_ASSERT(output.length() > 0, "can't read zero bytes from input streams");
+
+        // direct descriptors would reject unaligned reads, so they go through the stream itself
+        if (const auto fd_stream = dynamic_cast<fd_input_stream*>(&stream); fd_stream != nullptr && !fd_stream->is_direct())
+        {
+            operation.m_stream = &stream;
+            m_engine.submit_read(fd_stream->fd(), stream.position(), output, reinterpret_cast<uint64_t>(&operation));
+            m_engine_ops++;
+            return;
+        }
+
+        operation.m_blocking = [&stream, output]() { return stream.read_bytes(output); };
+        schedule_blocking(operation);
+    }
+
+    ///
+    /// @brief      Run an operation on a worker thread, and resume its coroutine once it completes.
+    /// @param      operation    State of the operation, which must stay alive until it completes.
+    ///
+    void
+    event_loop::schedule_blocking(async_operation& operation)
+    {
+        {
+            std::lock_guard lock{ m_mutex };
+            m_jobs.push_back(&operation);
+        }
+        m_work.notify_one();
+        m_blocking_ops++;
+    }
+
+    void
+    event_loop::step()
+    {
+        while (!m_ready.empty())
+        {
+            const auto handle = m_ready.front();
+            m_ready.pop_front();
+            handle.resume();
+        }
+
+        collect_tasks();
+
+        if (has_pending())
+        {
+            wait_for_events();
+        }
+    }
+
+    void
+    event_loop::collect_tasks()
+    {
+        const auto finished = std::ranges::remove_if(m_tasks, [this](task<void>& detached) {
+            if (!detached.done())
+            {
+                return false;
+            }
+
+            if (detached.handle().promise().m_error && !m_task_error)
+            {
+                m_task_error = detached.handle().promise().m_error;
+            }
+            return true;
+        });
+
+        m_tasks.erase(finished.begin(), finished.end());
+    }
+
+    void
+    event_loop::wait_for_events()
+    {
+        if (m_engine_ops > 0u || m_wakeup_armed)
+        {
+            // with io_uring, worker completions have to interrupt waiting for the engine;
+            // the fallback executes reads right away, so it never blocks for long anyway
+            if (m_blocking_ops > 0u && !m_wakeup_armed && m_engine.backend() == io_backend::uring)
+            {
+                m_engine.submit_read(m_wakeup[0], 0, weak_buffer{ m_wakeup_buffer, sizeof(m_wakeup_buffer) }, k_wakeup_tag);
+                m_wakeup_armed = true;
+            }
+
+            m_completions.clear();
+            m_engine.wait(m_completions, 1u);
+
+            for (const auto& completion : m_completions)
+            {
+                if (completion.m_tag == k_wakeup_tag)
+                {
+                    m_wakeup_armed = false;
+                    continue;
+                }
+
+                const auto operation = reinterpret_cast<async_operation*>(completion.m_tag);
+                operation->m_result = std::max<int64_t>(completion.m_result, 0);
+                operation->m_stream->seek_current(operation->m_result);
+
+                m_engine_ops--;
+                m_ready.push_back(operation->m_handle);
+            }
+        }
+        else if (m_blocking_ops > 0u)
+        {
+            std::unique_lock lock{ m_mutex };
+            m_finished.wait(lock, [this]() { return !m_done.empty(); });
+        }
+
+        drain_blocking();
+    }
+
+    void
+    event_loop::drain_blocking()
+    {
+        std::lock_guard lock{ m_mutex };
+
+        for (const auto operation : m_done)
+        {
+            m_ready.push_back(operation->m_handle);
+        }
+
+        m_blocking_ops -= m_done.size();
+        m_done.clear();
+    }
+
+    void
+    event_loop::stop_workers() noexcept
+    {
+        {
+            std::lock_guard lock{ m_mutex };
+            m_stopping = true;
+        }
+        m_work.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void
+    event_loop::worker_main()
+    {
+        std::unique_lock lock{ m_mutex };
+
+        while (true)
+        {
+            m_work.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+
+            if (m_stopping)
+            {
+                return;
+            }
+
+            const auto operation = m_jobs.front();
+            m_jobs.pop_front();
+            lock.unlock();
+
+            try
+            {
+                operation->m_result = operation->m_blocking();
+            }
+            catch (...)
+            {
+                operation->m_error = std::current_exception();
+            }
+
+            lock.lock();
+            m_done.push_back(operation);
+            m_finished.notify_one();
+
+            [[maybe_unused]] const auto written = ::write(m_wakeup[1], "", 1u);
+        }
+    }
+
+    bool
+    event_loop::has_pending() const noexcept
+    {
+        return m_engine_ops > 0u || m_blocking_ops > 0u;
+    }
+
+
+
+    void
+    async_read_awaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        const auto loop = event_loop::current();
+        REIO_ASSERT(loop != nullptr, "async operations have to be awaited on a running event loop");
+
+        m_operation.m_handle = handle;
+        loop->schedule_read(m_operation, *m_stream, m_output);
+    }
+
+    int64_t
+    async_read_awaiter::await_resume()
+    {
+        if (m_operation.m_error)
+        {
+            std::rethrow_exception(m_operation.m_error);
+        }
+        return m_operation.m_result;
+    }
+
+    async_write_awaiter::async_write_awaiter(output_stream& stream, weak_buffer input)
+    {
+        REIO_ASSERT(input.data() != nullptr, "can't write to output streams from nullptr");
+        REIO_ASSERT(input.length() > 0, "can't write zero bytes to output streams");
+
+        m_operation.m_blocking = [&stream, input]() { return stream.write_bytes(input); };
+    }
+
+    void
+    async_write_awaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        const auto loop = event_loop::current();
+        REIO_ASSERT(loop != nullptr, "async operations have to be awaited on a running event loop");
+
+        m_operation.m_handle = handle;
+        loop->schedule_blocking(m_operation);
+    }
+
+    int64_t
+    async_write_awaiter::await_resume()
+    {
+        if (m_operation.m_error)
+        {
+            std::rethrow_exception(m_operation.m_error);
+        }
+        return m_operation.m_result;
+    }
+
+}
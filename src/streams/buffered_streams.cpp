@@ -0,0 +1,424 @@
+#include "reio/streams/buffered_streams.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace reio
+{
+
+    buffered_input_stream::buffered_input_stream(input_stream* source, std::size_t window, base_allocator* alloc)
+        : m_source{ source }
+        , m_window{ window, alloc }
+        , m_window_start{ 0 }
+        , m_window_length{ 0u }
+        , m_cursor{ 0u }
+    {
+        REIO_ASSERT(source != nullptr, "can't initialize buffered input stream with a null source");
+        REIO_ASSERT(window != 0u, "can't initialize buffered input stream with an empty window");
+
+        m_window.set_growth(growth_factor::none);
+        m_window.resize_to_capacity();
+        m_window_start = source->position();
+    }
+
+    buffered_input_stream::~buffered_input_stream() = default;
+
+    ///
+    /// @brief      Get the wrapped stream.
+    /// @return     Pointer to the stream which is used as a data source.
+    ///
+    input_stream*
+    buffered_input_stream::source() const noexcept
+    {
+        return m_source;
+    }
+
+    ///
+    /// @brief      Get the maximum number of bytes which can be buffered at once.
+    /// @return     Capacity (in bytes) of the internal window.
+    ///
+    std::size_t
+    buffered_input_stream::window_capacity() const noexcept
+    {
+        return m_window.capacity();
+    }
+
+    ///
+    /// @brief      Get a view of the bytes which are currently buffered.
+    /// @return     View over the valid part of the internal window.
+    ///
+    weak_buffer
+    buffered_input_stream::window() const noexcept
+    {
+        return { m_window.data(), m_window_length };
+    }
+
+    int64_t
+    buffered_input_stream::position()
+    {
+        return m_window_start + static_cast<int64_t>(m_cursor);
+    }
+
+    int64_t
+    buffered_input_stream::length()
+    {
+        return m_source->length();
+    }
+
+    void
+    buffered_input_stream::seek_begin(int64_t offset)
+    {
+        if (try_seek_within(offset))
+        {
+            return;
+        }
+
+        m_source->seek_begin(offset);
+        m_window_start = offset;
+        drop_window();
+    }
+
+    void
+    buffered_input_stream::seek_current(int64_t offset)
+    {
+        const auto target = position() + offset;
+        if (try_seek_within(target))
+        {
+            return;
+        }
+
+        // the wrapped stream is positioned at the end of the window,
+        // so the offset has to be rebased to keep its own seek checks intact
+        const auto source_position = m_window_start + static_cast<int64_t>(m_window_length);
+        m_source->seek_current(target - source_position);
+        m_window_start = target;
+        drop_window();
+    }
+
+    void
+    buffered_input_stream::seek_end(int64_t offset)
+    {
+        // checking the window would require a length() call which isn't cheap
+        // for every stream, so seeking from the end always goes through the source
+        m_source->seek_end(offset);
+        m_window_start = m_source->position();
+        drop_window();
+    }
+
+    int64_t
+    buffered_input_stream::read_bytes(weak_buffer output)
+    {
+        REIO_ASSERT(output.data() != nullptr, "can't read from input streams into nullptr");
+        REIO_ASSERT(output.length() > 0, "can't read zero bytes from input streams");
+
+        auto dest = output.data();
+        auto remaining = output.length();
+
+        while (remaining > 0u)
+        {
+            const auto buffered = m_window_length - m_cursor;
+            if (buffered > 0u)
+            {
+                const auto served = std::min(buffered, remaining);
+                std::copy_n(m_window.data() + m_cursor, served, dest);
+
+                m_cursor += served;
+                dest += served;
+                remaining -= served;
+                continue;
+            }
+
+            // big reads would only be copied twice through the window
+            if (remaining >= m_window.capacity())
+            {
+                const auto read = m_source->read_bytes(weak_buffer{ dest, remaining });
+                const auto read_ = static_cast<std::size_t>(std::max<int64_t>(read, 0));
+
+                m_window_start += static_cast<int64_t>(m_window_length + read_);
+                drop_window();
+
+                remaining -= read_;
+                break;
+            }
+
+            if (refill() == 0u)
+            {
+                break;
+            }
+        }
+
+        return static_cast<int64_t>(output.length() - remaining);
+    }
+
+    int64_t
+    buffered_input_stream::read_byte()
+    {
+        if (m_cursor == m_window_length && refill() == 0u)
+        {
+            return -1;
+        }
+
+        return static_cast<int64_t>(m_window[m_cursor++]);
+    }
+
+    bool
+    buffered_input_stream::try_seek_within(int64_t target) noexcept
+    {
+        const auto window_end = m_window_start + static_cast<int64_t>(m_window_length);
+        if (target < m_window_start || target >= window_end)
+        {
+            return false;
+        }
+
+        m_cursor = static_cast<std::size_t>(target - m_window_start);
+        return true;
+    }
+
+    void
+    buffered_input_stream::drop_window() noexcept
+    {
+        m_window_length = 0u;
+        m_cursor = 0u;
+    }
+
+    std::size_t
+    buffered_input_stream::refill()
+    {
+        m_window_start += static_cast<int64_t>(m_window_length);
+        drop_window();
+
+        const auto read = m_source->read_bytes(m_window.view());
+        m_window_length = static_cast<std::size_t>(std::max<int64_t>(read, 0));
+
+        return m_window_length;
+    }
+
+
+
+    buffered_output_stream::buffered_output_stream(output_stream* sink, std::size_t window, base_allocator* alloc)
+        : m_sink{ sink }
+        , m_window{ window, alloc }
+        , m_window_start{ 0 }
+        , m_window_length{ 0u }
+        , m_cursor{ 0u }
+    {
+        REIO_ASSERT(sink != nullptr, "can't initialize buffered output stream with a null sink");
+        REIO_ASSERT(window != 0u, "can't initialize buffered output stream with an empty window");
+
+        m_window.set_growth(growth_factor::none);
+        m_window.resize_to_capacity();
+        m_window_start = sink->position();
+    }
+
+    buffered_output_stream::~buffered_output_stream()
+    {
+        [[maybe_unused]] bool ok = true;
+        try
+        {
+            ok = write_window();
+        }
+        catch (...)
+        {
+            ok = false;
+        }
+
+#ifdef _DEBUG
+        if (!ok)
+        {
+            std::fputs("warning: failed to flush pending bytes in ~buffered_output_stream", stderr);
+        }
+#endif
+    }
+
+    ///
+    /// @brief      Get the wrapped stream.
+    /// @return     Pointer to the stream which is used as a data sink.
+    ///
+    output_stream*
+    buffered_output_stream::sink() const noexcept
+    {
+        return m_sink;
+    }
+
+    ///
+    /// @brief      Get the maximum number of bytes which can be pending at once.
+    /// @return     Capacity (in bytes) of the internal window.
+    ///
+    std::size_t
+    buffered_output_stream::window_capacity() const noexcept
+    {
+        return m_window.capacity();
+    }
+
+    ///
+    /// @brief      Get a view of the bytes which weren't flushed yet.
+    /// @return     View over the pending part of the internal window.
+    ///
+    weak_buffer
+    buffered_output_stream::window() const noexcept
+    {
+        return { m_window.data(), m_window_length };
+    }
+
+    ///
+    /// @brief      Write all pending bytes into the wrapped stream.
+    ///
+    /// Afterwards, the wrapped stream is positioned at this stream's
+    /// current position, even if the cursor was moved back within the window.
+    ///
+    /// @throw      io_exception    If the wrapped stream didn't accept all pending bytes.
+    ///
+    void
+    buffered_output_stream::flush()
+    {
+        [[maybe_unused]] const auto ok = write_window();
+        REIO_ASSERT(ok, "failed to flush pending bytes into the wrapped stream");
+
+        if (m_cursor != m_window_length)
+        {
+            const auto rewind = static_cast<int64_t>(m_cursor) - static_cast<int64_t>(m_window_length);
+            m_sink->seek_current(rewind);
+        }
+
+        m_window_start += static_cast<int64_t>(m_cursor);
+        m_window_length = 0u;
+        m_cursor = 0u;
+    }
+
+    int64_t
+    buffered_output_stream::position()
+    {
+        return m_window_start + static_cast<int64_t>(m_cursor);
+    }
+
+    int64_t
+    buffered_output_stream::length()
+    {
+        // the pending block might either overwrite existing bytes, or extend the sink
+        const auto window_end = m_window_start + static_cast<int64_t>(m_window_length);
+        return std::max(m_sink->length(), window_end);
+    }
+
+    void
+    buffered_output_stream::seek_begin(int64_t offset)
+    {
+        if (try_seek_within(offset))
+        {
+            return;
+        }
+
+        flush();
+        m_sink->seek_begin(offset);
+        m_window_start = offset;
+    }
+
+    void
+    buffered_output_stream::seek_current(int64_t offset)
+    {
+        if (try_seek_within(position() + offset))
+        {
+            return;
+        }
+
+        flush();
+        m_sink->seek_current(offset);
+        m_window_start += offset;
+    }
+
+    void
+    buffered_output_stream::seek_end(int64_t offset)
+    {
+        flush();
+        m_sink->seek_end(offset);
+        m_window_start = m_sink->position();
+    }
+
+    ///
+    /// @brief      Put bytes into the internal window, flushing it as it fills up.
+    ///
+    /// @param      input           View of memory to write; implicitly defines the written number of bytes.
+    /// @throw      io_exception    If a flush caused by this write fails.
+    ///
+    /// @return     Number of bytes accepted by this stream.
+    ///
+    int64_t
+    buffered_output_stream::write_bytes(weak_buffer input)
+    {
+        REIO_ASSERT(input.data() != nullptr, "can't write to output streams from nullptr");
+        REIO_ASSERT(input.length() > 0, "can't write zero bytes to output streams");
+
+        // big writes would only be copied twice through the window
+        if (input.length() >= m_window.capacity())
+        {
+            flush();
+
+            const auto written = m_sink->write_bytes(input);
+            m_window_start += std::max<int64_t>(written, 0);
+
+            return written;
+        }
+
+        auto src = input.data();
+        auto remaining = input.length();
+
+        while (remaining > 0u)
+        {
+            const auto space = m_window.capacity() - m_cursor;
+            if (space == 0u)
+            {
+                flush();
+                continue;
+            }
+
+            const auto accepted = std::min(space, remaining);
+            std::copy_n(src, accepted, m_window.data() + m_cursor);
+
+            m_cursor += accepted;
+            m_window_length = std::max(m_window_length, m_cursor);
+            src += accepted;
+            remaining -= accepted;
+        }
+
+        return static_cast<int64_t>(input.length());
+    }
+
+    bool
+    buffered_output_stream::write_byte(byte value)
+    {
+        if (m_cursor == m_window.capacity())
+        {
+            flush();
+        }
+
+        m_window[m_cursor++] = value;
+        m_window_length = std::max(m_window_length, m_cursor);
+
+        return true;
+    }
+
+    bool
+    buffered_output_stream::try_seek_within(int64_t target) noexcept
+    {
+        // unlike input, the end of the pending block is a valid position too
+        const auto window_end = m_window_start + static_cast<int64_t>(m_window_length);
+        if (target < m_window_start || target > window_end)
+        {
+            return false;
+        }
+
+        m_cursor = static_cast<std::size_t>(target - m_window_start);
+        return true;
+    }
+
+    bool
+    buffered_output_stream::write_window()
+    {
+        if (m_window_length == 0u)
+        {
+            return true;
+        }
+
+        const auto written = m_sink->write_bytes(weak_buffer{ m_window.data(), m_window_length });
+        return written == static_cast<int64_t>(m_window_length);
+    }
+
+}
@@ -0,0 +1,160 @@
+#include "reio/streams/engine_streams.hpp"
+#include "./fd_helpers.hpp"
+
+#include <algorithm>
+#include <vector>
+
+
+namespace reio
+{
+
+    ///
+    /// @brief      Initialize stream by acquiring ownership of a file descriptor.
+    ///             The descriptor is closed by the stream.
+    ///
+    /// @param      fd          Externally-opened readable descriptor; reading starts at its current offset.
+    /// @param      options     Options of the stream's engine.
+    ///
+    engine_input_stream::engine_input_stream(int fd, io_engine_options options)
+        : m_engine{ options }
+        , m_fd{ fd }
+    {
+        REIO_ASSERT(fd >= 0, "can't initialize engine stream with an invalid descriptor");
+        m_position = DoFdPosition(fd);
+        m_length = DoFdLength(fd);
+    }
+
+    ///
+    /// @brief      Initialize stream by opening a physical file.
+    ///
+    /// @param      path            Path to the file which should be used for input.
+    /// @param      extra_flags     Flags to add to @c O_RDONLY, e.g. @c O_NOATIME.
+    /// @param      options         Options of the stream's engine.
+    ///
+    engine_input_stream::engine_input_stream(std::string_view path, int extra_flags, io_engine_options options)
+        : m_engine{ options }
+        , m_fd{ DoOpenFd(path, O_RDONLY | extra_flags) }
+    {
+        m_length = DoFdLength(m_fd);
+    }
+
+    engine_input_stream::~engine_input_stream()
+    {
+        DoCloseFd(m_fd, "warning: close reported failure in ~engine_input_stream");
+    }
+
+    ///
+    /// @brief      Get the underlying descriptor, which is still owned by the stream.
+    /// @return     File descriptor.
+    ///
+    int
+    engine_input_stream::fd() const noexcept
+    {
+        return m_fd;
+    }
+
+    ///
+    /// @brief      Get the engine which executes reads, e.g. to check its backend.
+    /// @return     Engine owned by the stream.
+    ///
+    const io_engine&
+    engine_input_stream::engine() const noexcept
+    {
+        return m_engine;
+    }
+
+    ///
+    /// @brief      Query the file length again, e.g. after it was modified by someone else.
+    /// @return     Up-to-date length of the file.
+    ///
+    int64_t
+    engine_input_stream::refresh_length()
+    {
+        m_length = DoFdLength(m_fd);
+        return m_length;
+    }
+
+    int64_t
+    engine_input_stream::position()
+    {
+        return m_position;
+    }
+
+    int64_t
+    engine_input_stream::length()
+    {
+        return m_length;
+    }
+
+    void
+    engine_input_stream::seek_begin(int64_t offset)
+    {
+        m_position = DoCalcFdPosition(0, offset);
+    }
+
+    void
+    engine_input_stream::seek_current(int64_t offset)
+    {
+        m_position = DoCalcFdPosition(m_position, offset);
+    }
+
+    void
+    engine_input_stream::seek_end(int64_t offset)
+    {
+        m_position = DoCalcFdPosition(m_length, offset);
+    }
+
+    int64_t
+    engine_input_stream::read_bytes(weak_buffer output)
+    {
+        REIO_ASSERT(output.data() != nullptr, "can't read from input streams into nullptr");
+        REIO_ASSERT(output.length() > 0, "can't read zero bytes from input streams");
+
+        return read_bytes_scatter(std::span{ &output, 1u });
+    }
+
+    int64_t
+    engine_input_stream::read_bytes_scatter(std::span<const weak_buffer> outputs)
+    {
+        std::vector<io_completion> completions;
+        int64_t total = 0;
+
+        // buffers are read in batches of up to the queue depth, and the transfer
+        // stops at the first short read or error, like with vectored reads
+        while (!outputs.empty())
+        {
+            const auto batch = outputs.first(std::min<std::size_t>(outputs.size(), m_engine.queue_depth()));
+            outputs = outputs.subspan(batch.size());
+
+            auto offset = m_position + total;
+            for (std::size_t i = 0u; i < batch.size(); i++)
+            {
+                if (batch[i].length() > 0u)
+                {
+                    m_engine.submit_read(m_fd, offset, batch[i], i);
+                    offset += static_cast<int64_t>(batch[i].length());
+                }
+            }
+
+            completions.clear();
+            m_engine.wait(completions, m_engine.in_flight());
+            std::ranges::sort(completions, {}, &io_completion::m_tag);
+
+            for (const auto& completion : completions)
+            {
+                total += std::max<int64_t>(completion.m_result, 0);
+
+                // regular files only return short reads at EOF, so nothing after it is valid
+                if (completion.m_result != static_cast<int64_t>(batch[completion.m_tag].length()))
+                {
+                    m_position += total;
+                    return total;
+                }
+            }
+        }
+
+        m_position += total;
+        return total;
+    }
+
+}
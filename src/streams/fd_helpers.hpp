@@ -0,0 +1,104 @@
+#ifndef REIO_FD_HELPERS_HPP
+#define REIO_FD_HELPERS_HPP
+
+#include "reio/asserts.hpp"
+#include "reio/types.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef REIO_PLATFORM_POSIX
+    #error Descriptor helpers are only implemented for POSIX platforms
+#endif
+
+
+namespace reio
+{
+
+    inline int DoOpenFd(std::string_view path, int flags)
+    {
+        const int fd = ::open(path.data(), flags | O_CLOEXEC, 0644);
+        REIO_ASSERT(fd != -1, "failed to open a file for fd stream");
+        return fd;
+    }
+
+    inline int64_t DoFdPosition(int fd)
+    {
+        // descriptors are taken over at their current offset, if they have one
+        const auto offset = ::lseek(fd, 0, SEEK_CUR);
+        return offset == -1 ? 0 : static_cast<int64_t>(offset);
+    }
+
+    inline int64_t DoFdLength(int fd)
+    {
+        struct stat info{};
+        [[maybe_unused]] const auto rc = ::fstat(fd, &info);
+        REIO_ASSERT(rc == 0, "failed to get the size of a file for fd stream");
+        return static_cast<int64_t>(info.st_size);
+    }
+
+    inline void DoCloseFd(int fd, [[maybe_unused]] const char* warning) noexcept
+    {
+        if (fd == -1)
+        {
+            return;
+        }
+
+        [[maybe_unused]] const auto rc = ::close(fd);
+
+#ifdef _DEBUG
+        if (rc != 0)
+        {
+            std::fputs(warning, stderr);
+        }
+#endif
+    }
+
+    ///
+    /// @brief      Validate and calculate a new cursor position within a file.
+    ///
+    /// Same as with CRT file streams, seeking past the end is allowed
+    /// (writing there extends the file), but seeking before the start isn't.
+    ///
+    inline int64_t DoCalcFdPosition(int64_t base, int64_t offset)
+    {
+        const auto new_position = base + offset;
+        REIO_ASSERT(new_position >= 0, "can't seek offset below the file's start");
+        return new_position;
+    }
+
+    ///
+    /// @brief      Transfer a single block at a file offset, continuing short transfers.
+    ///
+    template<bool Write>
+    inline int64_t DoTransfer(int fd, int64_t offset, byte* data, std::size_t size)
+    {
+        int64_t total = 0;
+        while (static_cast<std::size_t>(total) < size)
+        {
+            const auto remaining = size - static_cast<std::size_t>(total);
+            const auto done = Write
+                ? ::pwrite(fd, data + total, remaining, static_cast<off_t>(offset + total))
+                : ::pread(fd, data + total, remaining, static_cast<off_t>(offset + total));
+
+            if (done < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (done <= 0)
+            {
+                break;
+            }
+
+            total += done;
+        }
+        return total;
+    }
+
+}
+
+#endif //REIO_FD_HELPERS_HPP
@@ -0,0 +1,624 @@
+#include "reio/streams/fd_streams.hpp"
+#include "./fd_helpers.hpp"
+#include "./vectored_helpers.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+
+
+namespace reio
+{
+
+    //* Helpers for descriptors opened with O_DIRECT.
+    //* ========================================
+
+    static bool DoIsDirectFd(int fd) noexcept
+    {
+#ifdef O_DIRECT
+        const auto flags = ::fcntl(fd, F_GETFL);
+        return flags != -1 && (flags & O_DIRECT) != 0;
+#else
+        return false;
+#endif
+    }
+
+    static constexpr int64_t DoAlignDown(int64_t value) noexcept
+    {
+        return value - value % static_cast<int64_t>(k_direct_io_alignment);
+    }
+
+    static constexpr std::size_t DoAlignUp(std::size_t value) noexcept
+    {
+        return (value + k_direct_io_alignment - 1u) / k_direct_io_alignment * k_direct_io_alignment;
+    }
+
+    static bool DoIsAlignedTransfer(int64_t offset, const byte* data, std::size_t size) noexcept
+    {
+        return offset % static_cast<int64_t>(k_direct_io_alignment) == 0
+            && reinterpret_cast<std::uintptr_t>(data) % k_direct_io_alignment == 0u
+            && size % k_direct_io_alignment == 0u;
+    }
+
+    static owning_buffer DoMakeDirectBuffer(std::size_t size)
+    {
+        owning_buffer buffer{ size, aligned_allocator::get_default() };
+        buffer.resize_to_capacity();
+        return buffer;
+    }
+
+    ///
+    /// @brief      Read a block through a descriptor opened with @c O_DIRECT.
+    ///
+    /// Aligned requests are passed to the kernel as they are, others are read
+    /// in aligned chunks into @c buffer, and copied out from there.
+    ///
+    /// @param      buffer      Aligned buffer, whose length is a multiple of the alignment.
+    ///
+    static int64_t DoReadDirect(int fd, int64_t offset, byte* data, std::size_t size, weak_buffer buffer)
+    {
+        if (DoIsAlignedTransfer(offset, data, size))
+        {
+            return DoTransfer<false>(fd, offset, data, size);
+        }
+
+        int64_t total = 0;
+        while (static_cast<std::size_t>(total) < size)
+        {
+            const auto chunk_offset = DoAlignDown(offset + total);
+            const auto skipped = static_cast<std::size_t>(offset + total - chunk_offset);
+            const auto wanted = size - static_cast<std::size_t>(total);
+            const auto chunk_size = std::min(buffer.length(), DoAlignUp(skipped + wanted));
+
+            // short reads only happen at the end of file
+            const auto read = DoTransfer<false>(fd, chunk_offset, buffer.data(), chunk_size);
+            if (read <= static_cast<int64_t>(skipped))
+            {
+                break;
+            }
+
+            const auto useful = std::min(static_cast<std::size_t>(read) - skipped, wanted);
+            std::memcpy(data + total, buffer.data() + skipped, useful);
+            total += static_cast<int64_t>(useful);
+
+            if (read < static_cast<int64_t>(chunk_size))
+            {
+                break;
+            }
+        }
+        return total;
+    }
+
+
+    ///
+    /// @brief      Initialize stream by acquiring ownership of a file descriptor.
+    ///             The descriptor is closed by the stream.
+    /// @param      fd      Externally-opened readable descriptor; reading starts at its current offset.
+    ///
+    fd_input_stream::fd_input_stream(int fd)
+        : m_fd{ fd }
+    {
+        REIO_ASSERT(fd >= 0, "can't initialize fd stream with an invalid descriptor");
+        m_position = DoFdPosition(fd);
+        m_length = DoFdLength(fd);
+        m_direct = DoIsDirectFd(fd);
+    }
+
+    ///
+    /// @brief      Initialize stream by opening a physical file.
+    /// @param      path            Path to the file which should be used for input.
+    /// @param      extra_flags     Flags to add to @c O_RDONLY, e.g. @c O_NOATIME or @c O_DIRECT.
+    ///
+    fd_input_stream::fd_input_stream(std::string_view path, int extra_flags)
+        : m_fd{ DoOpenFd(path, O_RDONLY | extra_flags) }
+    {
+        m_length = DoFdLength(m_fd);
+        m_direct = DoIsDirectFd(m_fd);
+    }
+
+    fd_input_stream::~fd_input_stream()
+    {
+        DoCloseFd(m_fd, "warning: close reported failure in ~fd_input_stream");
+    }
+
+    fd_input_stream::fd_input_stream(fd_input_stream &&other) noexcept
+        : m_fd{ std::exchange(other.m_fd, -1) }
+        , m_position{ std::exchange(other.m_position, 0) }
+        , m_length{ std::exchange(other.m_length, 0) }
+        , m_direct{ std::exchange(other.m_direct, false) }
+        , m_direct_buffer{ std::move(other.m_direct_buffer) }
+    {
+
+    }
+
+    fd_input_stream &
+    fd_input_stream::operator=(fd_input_stream &&other) noexcept
+    {
+        if (this != &other) {
+            DoCloseFd(m_fd, "warning: close reported failure in fd_input_stream::operator=");
+            m_fd = std::exchange(other.m_fd, -1);
+            m_position = std::exchange(other.m_position, 0);
+            m_length = std::exchange(other.m_length, 0);
+            m_direct = std::exchange(other.m_direct, false);
+            m_direct_buffer = std::move(other.m_direct_buffer);
+        }
+
+        return *this;
+    }
+
+    ///
+    /// @brief      Get the underlying descriptor, which is still owned by the stream.
+    /// @return     File descriptor, or @c -1 if the stream was moved from.
+    ///
+    int
+    fd_input_stream::fd() const noexcept
+    {
+        return m_fd;
+    }
+
+    ///
+    /// @brief      Give up ownership of the underlying descriptor.
+    ///
+    /// The stream can't be used afterwards. The descriptor's file offset
+    /// isn't synchronized with the stream's position.
+    ///
+    /// @return     File descriptor, which has to be closed by the caller.
+    ///
+    int
+    fd_input_stream::release() noexcept
+    {
+        m_position = m_length = 0;
+        return std::exchange(m_fd, -1);
+    }
+
+    ///
+    /// @brief      Check whether the descriptor bypasses the page cache.
+    /// @return     Whether it was opened with @c O_DIRECT.
+    ///
+    bool
+    fd_input_stream::is_direct() const noexcept
+    {
+        return m_direct;
+    }
+
+    ///
+    /// @brief      Query the file length again, e.g. after it was modified by someone else.
+    /// @return     Up-to-date length of the file.
+    ///
+    int64_t
+    fd_input_stream::refresh_length()
+    {
+        m_length = DoFdLength(m_fd);
+        return m_length;
+    }
+
+    int64_t
+    fd_input_stream::position()
+    {
+        return m_position;
+    }
+
+    int64_t
+    fd_input_stream::length()
+    {
+        return m_length;
+    }
+
+    void
+    fd_input_stream::seek_begin(int64_t offset)
+    {
+        m_position = DoCalcFdPosition(0, offset);
+    }
+
+    void
+    fd_input_stream::seek_current(int64_t offset)
+    {
+        m_position = DoCalcFdPosition(m_position, offset);
+    }
+
+    void
+    fd_input_stream::seek_end(int64_t offset)
+    {
+        m_position = DoCalcFdPosition(m_length, offset);
+    }
+
+    int64_t
+    fd_input_stream::read_bytes(weak_buffer output)
+    {
+        REIO_ASSERT(output.data() != nullptr, "can't read from input streams into nullptr");
+        REIO_ASSERT(output.length() > 0, "can't read zero bytes from input streams");
+
+        int64_t read = 0;
+        if (m_direct)
+        {
+            if (m_direct_buffer.capacity() == 0u && !DoIsAlignedTransfer(m_position, output.data(), output.length()))
+            {
+                m_direct_buffer = DoMakeDirectBuffer(k_direct_io_buffer_size);
+            }
+            read = DoReadDirect(m_fd, m_position, output.data(), output.length(), m_direct_buffer.view());
+        }
+        else
+        {
+            read = DoTransfer<false>(m_fd, m_position, output.data(), output.length());
+        }
+        m_position += read;
+
+        return read;
+    }
+
+    int64_t
+    fd_input_stream::read_bytes_scatter(std::span<const weak_buffer> outputs)
+    {
+        if (m_direct)
+        {
+            // preadv would need every single buffer to be aligned
+            return input_stream::read_bytes_scatter(outputs);
+        }
+
+        const auto read = DoTransferVectored<false>(m_fd, m_position, outputs);
+        m_position += read;
+
+        return read;
+    }
+
+    int64_t
+    fd_input_stream::size() const
+    {
+        return m_length;
+    }
+
+    int64_t
+    fd_input_stream::read_at(int64_t offset, weak_buffer output) const
+    {
+        REIO_ASSERT(offset >= 0, "can't read at a negative offset");
+        REIO_ASSERT(output.data() != nullptr, "can't read into nullptr");
+        REIO_ASSERT(output.length() > 0, "can't read zero bytes");
+
+        if (m_direct && !DoIsAlignedTransfer(offset, output.data(), output.length()))
+        {
+            // the stream's buffer can't be shared between concurrent calls
+            const auto buffer = DoMakeDirectBuffer(std::min(k_direct_io_buffer_size, DoAlignUp(output.length()) + k_direct_io_alignment));
+            return DoReadDirect(m_fd, offset, output.data(), output.length(), buffer.view());
+        }
+
+        // pread doesn't touch the descriptor's offset, so concurrent calls are safe
+        return DoTransfer<false>(m_fd, offset, output.data(), output.length());
+    }
+
+
+
+    ///
+    /// @brief      Initialize stream by acquiring ownership of a file descriptor.
+    ///             The descriptor is closed by the stream.
+    /// @param      fd      Externally-opened writable descriptor; writing starts at its current offset.
+    ///
+    fd_output_stream::fd_output_stream(int fd)
+        : m_fd{ fd }
+    {
+        REIO_ASSERT(fd >= 0, "can't initialize fd stream with an invalid descriptor");
+
+        const auto flags = ::fcntl(fd, F_GETFL);
+        REIO_ASSERT((flags & O_APPEND) == 0, "fd output stream can't use append-mode descriptors");
+
+        m_position = DoFdPosition(fd);
+        m_length = DoFdLength(fd);
+        m_direct = DoIsDirectFd(fd);
+
+        // partially written blocks have to be merged with what's on disk
+        REIO_ASSERT(!m_direct || (flags & O_ACCMODE) == O_RDWR, "direct fd output stream needs a readable descriptor");
+    }
+
+    ///
+    /// @brief      Initialize stream by creating or truncating a physical file.
+    /// @param      path            Path to the file which should be used for output.
+    /// @param      extra_flags     Flags to add to @c O_WRONLY | @c O_CREAT | @c O_TRUNC, e.g. @c O_DSYNC;
+    ///                             with @c O_DIRECT, the file is opened with @c O_RDWR instead.
+    ///
+    fd_output_stream::fd_output_stream(std::string_view path, int extra_flags)
+    {
+        REIO_ASSERT((extra_flags & O_APPEND) == 0, "fd output stream can't use append-mode descriptors");
+
+        auto access = O_WRONLY;
+#ifdef O_DIRECT
+        if ((extra_flags & O_DIRECT) != 0)
+        {
+            access = O_RDWR;
+        }
+#endif
+
+        m_fd = DoOpenFd(path, access | O_CREAT | O_TRUNC | extra_flags);
+        m_direct = DoIsDirectFd(m_fd);
+    }
+
+    fd_output_stream::~fd_output_stream()
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+#ifdef _DEBUG
+            std::fputs("warning: failed to flush direct fd stream in ~fd_output_stream", stderr);
+#endif
+        }
+
+        DoCloseFd(m_fd, "warning: close reported failure in ~fd_output_stream");
+    }
+
+    fd_output_stream::fd_output_stream(fd_output_stream &&other) noexcept
+        : m_fd{ std::exchange(other.m_fd, -1) }
+        , m_position{ std::exchange(other.m_position, 0) }
+        , m_length{ std::exchange(other.m_length, 0) }
+        , m_direct{ std::exchange(other.m_direct, false) }
+        , m_direct_buffer{ std::move(other.m_direct_buffer) }
+        , m_buffered_offset{ std::exchange(other.m_buffered_offset, 0) }
+        , m_buffered{ std::exchange(other.m_buffered, 0u) }
+    {
+
+    }
+
+    fd_output_stream &
+    fd_output_stream::operator=(fd_output_stream &&other) noexcept
+    {
+        if (this != &other) {
+            try
+            {
+                flush();
+            }
+            catch (...)
+            {
+#ifdef _DEBUG
+                std::fputs("warning: failed to flush direct fd stream in fd_output_stream::operator=", stderr);
+#endif
+            }
+
+            DoCloseFd(m_fd, "warning: close reported failure in fd_output_stream::operator=");
+            m_fd = std::exchange(other.m_fd, -1);
+            m_position = std::exchange(other.m_position, 0);
+            m_length = std::exchange(other.m_length, 0);
+            m_direct = std::exchange(other.m_direct, false);
+            m_direct_buffer = std::move(other.m_direct_buffer);
+            m_buffered_offset = std::exchange(other.m_buffered_offset, 0);
+            m_buffered = std::exchange(other.m_buffered, 0u);
+        }
+
+        return *this;
+    }
+
+    ///
+    /// @brief      Get the underlying descriptor, which is still owned by the stream.
+    /// @return     File descriptor, or @c -1 if the stream was moved from.
+    ///
+    int
+    fd_output_stream::fd() const noexcept
+    {
+        return m_fd;
+    }
+
+    ///
+    /// @brief      Give up ownership of the underlying descriptor.
+    ///
+    /// The stream can't be used afterwards. The descriptor's file offset
+    /// isn't synchronized with the stream's position.
+    ///
+    /// @return     File descriptor, which has to be closed by the caller.
+    ///
+    int
+    fd_output_stream::release() noexcept
+    {
+        m_position = m_length = 0;
+        m_buffered = 0u;
+        return std::exchange(m_fd, -1);
+    }
+
+    ///
+    /// @brief      Check whether the descriptor bypasses the page cache.
+    /// @return     Whether it was opened with @c O_DIRECT.
+    ///
+    bool
+    fd_output_stream::is_direct() const noexcept
+    {
+        return m_direct;
+    }
+
+    ///
+    /// @brief      Query the file length again, e.g. after it was modified by someone else.
+    /// @return     Up-to-date length of the file.
+    ///
+    int64_t
+    fd_output_stream::refresh_length()
+    {
+        flush();
+        m_length = DoFdLength(m_fd);
+        return m_length;
+    }
+
+    ///
+    /// @brief      Write out bytes collected for an @c O_DIRECT descriptor, e.g. before using @c fd.
+    ///
+    /// The last block is padded with what's on disk (or zeros past the end of file),
+    /// and the file is truncated back to its length afterwards. Does nothing
+    /// for regular descriptors, whose writes are never buffered.
+    ///
+    /// @throw      io_exception    If writing or truncating fails.
+    ///
+    void
+    fd_output_stream::flush()
+    {
+        if (m_buffered == 0u)
+        {
+            return;
+        }
+
+        const auto buffered_end = m_buffered_offset + static_cast<int64_t>(m_buffered);
+        const auto padded = DoAlignUp(m_buffered);
+
+        if (padded > m_buffered)
+        {
+            const auto padding = weak_buffer{ m_direct_buffer.data() + m_buffered, padded - m_buffered };
+            std::memset(padding.data(), 0, padding.length());
+
+            if (buffered_end < m_length)
+            {
+                const auto block = DoMakeDirectBuffer(k_direct_io_alignment);
+                const auto read = DoTransfer<false>(m_fd, DoAlignDown(buffered_end), block.data(), block.length());
+
+                const auto skipped = static_cast<std::size_t>(buffered_end - DoAlignDown(buffered_end));
+                if (read > static_cast<int64_t>(skipped))
+                {
+                    std::memcpy(padding.data(), block.data() + skipped, static_cast<std::size_t>(read) - skipped);
+                }
+            }
+        }
+
+        const auto written = DoTransfer<true>(m_fd, m_buffered_offset, m_direct_buffer.data(), padded);
+        REIO_ASSERT(written == static_cast<int64_t>(padded), "failed to write buffered blocks of direct fd stream");
+        m_buffered = 0u;
+
+        if (m_buffered_offset + static_cast<int64_t>(padded) > m_length)
+        {
+            [[maybe_unused]] const auto rc = ::ftruncate(m_fd, static_cast<off_t>(m_length));
+            REIO_ASSERT(rc == 0, "failed to truncate padding of direct fd stream");
+        }
+    }
+
+    int64_t
+    fd_output_stream::position()
+    {
+        return m_position;
+    }
+
+    int64_t
+    fd_output_stream::length()
+    {
+        return m_length;
+    }
+
+    void
+    fd_output_stream::seek_begin(int64_t offset)
+    {
+        m_position = DoCalcFdPosition(0, offset);
+    }
+
+    void
+    fd_output_stream::seek_current(int64_t offset)
+    {
+        m_position = DoCalcFdPosition(m_position, offset);
+    }
+
+    void
+    fd_output_stream::seek_end(int64_t offset)
+    {
+        m_position = DoCalcFdPosition(m_length, offset);
+    }
+
+    int64_t
+    fd_output_stream::write_bytes(weak_buffer input)
+    {
+        REIO_ASSERT(input.data() != nullptr, "can't write to output streams from nullptr");
+        REIO_ASSERT(input.length() > 0, "can't write zero bytes to output streams");
+
+        if (m_direct)
+        {
+            return write_direct(input);
+        }
+
+        const auto written = DoTransfer<true>(m_fd, m_position, input.data(), input.length());
+        m_position += written;
+        m_length = std::max(m_length, m_position);
+
+        return written;
+    }
+
+    int64_t
+    fd_output_stream::write_bytes_gather(std::span<const weak_buffer> inputs)
+    {
+        if (m_direct)
+        {
+            // pwritev would need every single buffer to be aligned
+            return output_stream::write_bytes_gather(inputs);
+        }
+
+        const auto written = DoTransferVectored<true>(m_fd, m_position, inputs);
+        m_position += written;
+        m_length = std::max(m_length, m_position);
+
+        return written;
+    }
+
+    int64_t
+    fd_output_stream::write_direct(weak_buffer input)
+    {
+        if (m_buffered > 0u && m_buffered_offset + static_cast<int64_t>(m_buffered) != m_position)
+        {
+            flush();
+        }
+
+        auto data = input.data();
+        auto remaining = input.length();
+
+        if (m_buffered == 0u)
+        {
+            // bulk writes from aligned memory skip the buffer
+            const auto bulk = remaining - remaining % k_direct_io_alignment;
+            if (bulk > 0u && DoIsAlignedTransfer(m_position, data, bulk))
+            {
+                const auto written = DoTransfer<true>(m_fd, m_position, data, bulk);
+                REIO_ASSERT(written == static_cast<int64_t>(bulk), "failed to write blocks of direct fd stream");
+
+                data += bulk;
+                remaining -= bulk;
+                m_position += static_cast<int64_t>(bulk);
+                m_length = std::max(m_length, m_position);
+            }
+
+            if (remaining == 0u)
+            {
+                return static_cast<int64_t>(input.length());
+            }
+
+            if (m_direct_buffer.capacity() == 0u)
+            {
+                m_direct_buffer = DoMakeDirectBuffer(k_direct_io_buffer_size);
+            }
+
+            // the buffer always starts at a block boundary, with the block's existing head merged in
+            m_buffered_offset = DoAlignDown(m_position);
+            m_buffered = static_cast<std::size_t>(m_position - m_buffered_offset);
+
+            if (m_buffered > 0u)
+            {
+                std::memset(m_direct_buffer.data(), 0, k_direct_io_alignment);
+                if (m_buffered_offset < m_length)
+                {
+                    DoTransfer<false>(m_fd, m_buffered_offset, m_direct_buffer.data(), k_direct_io_alignment);
+                }
+            }
+        }
+
+        while (remaining > 0u)
+        {
+            const auto chunk = std::min(remaining, m_direct_buffer.length() - m_buffered);
+            std::memcpy(m_direct_buffer.data() + m_buffered, data, chunk);
+
+            data += chunk;
+            remaining -= chunk;
+            m_buffered += chunk;
+            m_position += static_cast<int64_t>(chunk);
+            m_length = std::max(m_length, m_position);
+
+            if (m_buffered == m_direct_buffer.length())
+            {
+                const auto written = DoTransfer<true>(m_fd, m_buffered_offset, m_direct_buffer.data(), m_buffered);
+                REIO_ASSERT(written == static_cast<int64_t>(m_buffered), "failed to write buffered blocks of direct fd stream");
+
+                m_buffered_offset += static_cast<int64_t>(m_buffered);
+                m_buffered = 0u;
+            }
+        }
+
+        return static_cast<int64_t>(input.length());
+    }
+
+}
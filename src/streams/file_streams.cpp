@@ -1,6 +1,13 @@
 #include "reio/streams/file_streams.hpp"
+#include <algorithm>
 #include <limits>
 
+#ifdef REIO_PLATFORM_POSIX
+    #include "./vectored_helpers.hpp"
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#endif
+
 
 namespace reio
 {
@@ -36,8 +43,20 @@ namespace reio
         return pos;
     }
 
-    inline long DoGetLength(std::FILE* file)
+    ///
+    /// @brief      Query the length of a file.
+    ///
+    /// Pending CRT output must be flushed by the caller beforehand.
+    ///
+    inline int64_t DoGetLength(std::FILE* file)
     {
+#ifdef REIO_PLATFORM_POSIX
+        struct stat info{};
+        [[maybe_unused]] const auto rc = ::fstat(::fileno(file), &info);
+        REIO_ASSERT(rc == 0, "failed to get file length");
+
+        return static_cast<int64_t>(info.st_size);
+#else
         int rc;
         std::fpos_t pos{};
 
@@ -51,10 +70,10 @@ namespace reio
         REIO_ASSERT(!rc, "failed to restore file position");
 
         return len;
+#endif
     }
 
 
-
     ///
     /// @brief      Initialize stream by acquiring ownership of a file handle.
     ///             The handle is closed by the stream.
@@ -64,6 +83,7 @@ namespace reio
         : m_handle{ handle }
     {
         REIO_ASSERT(handle != nullptr, "can't initialize file stream with a null handle");
+        m_length = DoGetLength(m_handle);
     }
 
     ///
@@ -74,6 +94,7 @@ namespace reio
     {
         m_handle = std::fopen(path.data(), "rb");
         REIO_ASSERT(m_handle != nullptr, "failed to open a file for file stream");
+        m_length = DoGetLength(m_handle);
     }
 
     file_input_stream::~file_input_stream()
@@ -88,6 +109,17 @@ namespace reio
 #endif
     }
 
+    ///
+    /// @brief      Query the file length again, e.g. after it was appended to by someone else.
+    /// @return     Up-to-date length of the file.
+    ///
+    int64_t
+    file_input_stream::refresh_length()
+    {
+        m_length = DoGetLength(m_handle);
+        return m_length;
+    }
+
     int64_t
     file_input_stream::position()
     {
@@ -97,7 +129,7 @@ namespace reio
     int64_t
     file_input_stream::length()
     {
-        return DoGetLength(m_handle);
+        return m_length;
     }
 
     void
@@ -131,6 +163,21 @@ namespace reio
         return static_cast<int64_t>(read);
     }
 
+    int64_t
+    file_input_stream::read_bytes_scatter(std::span<const weak_buffer> outputs)
+    {
+#ifdef REIO_PLATFORM_POSIX
+        // read right past the logical position, then reposition the handle (dropping its read-ahead)
+        const auto start = static_cast<int64_t>(DoTell(m_handle));
+        const auto read = DoTransferVectored<false>(::fileno(m_handle), start, outputs);
+
+        DoSeek<seek_origin::begin>(m_handle, start + read);
+        return read;
+#else
+        return input_stream::read_bytes_scatter(outputs);
+#endif
+    }
+
 
 
     ///
@@ -142,6 +189,13 @@ namespace reio
         : m_handle{ handle }
     {
         REIO_ASSERT(handle != nullptr, "can't initialize file stream with a null handle");
+
+#ifdef REIO_PLATFORM_POSIX
+        m_append = (::fcntl(::fileno(m_handle), F_GETFL) & O_APPEND) != 0;
+#endif
+
+        m_position = DoTell(m_handle);
+        refresh_length();
     }
 
     ///
@@ -166,34 +220,54 @@ namespace reio
 #endif
     }
 
+    ///
+    /// @brief      Query the file length again, e.g. after it was modified by someone else.
+    ///
+    /// Flushes pending CRT output first.
+    ///
+    /// @return     Up-to-date length of the file, including everything written so far.
+    ///
+    int64_t
+    file_output_stream::refresh_length()
+    {
+        [[maybe_unused]] const auto rc = std::fflush(m_handle);
+        REIO_ASSERT(rc == 0, "failed to flush the file before querying its length");
+
+        m_length = DoGetLength(m_handle);
+        return m_length;
+    }
+
     int64_t
     file_output_stream::position()
     {
-        return DoTell(m_handle);
+        return m_position;
     }
 
     int64_t
     file_output_stream::length()
     {
-        return DoGetLength(m_handle);
+        return m_length;
     }
 
     void
     file_output_stream::seek_begin(int64_t offset)
     {
         DoSeek<seek_origin::begin>(m_handle, offset);
+        m_position = offset;
     }
 
     void
     file_output_stream::seek_current(int64_t offset)
     {
         DoSeek<seek_origin::current>(m_handle, offset);
+        m_position += offset;
     }
 
     void
     file_output_stream::seek_end(int64_t offset)
     {
         DoSeek<seek_origin::end>(m_handle, offset);
+        m_position = DoTell(m_handle);
     }
 
     int64_t
@@ -206,6 +280,45 @@ namespace reio
                 input.length(),
                 m_handle);
 
+        if (m_append)
+        {
+            // the write went to the end of file, wherever the stream was positioned
+            m_position = DoTell(m_handle);
+        }
+        else
+        {
+            m_position += static_cast<int64_t>(written);
+        }
+        m_length = std::max(m_length, m_position);
+
         return static_cast<int64_t>(written);
     }
+
+    int64_t
+    file_output_stream::write_bytes_gather(std::span<const weak_buffer> inputs)
+    {
+#ifdef REIO_PLATFORM_POSIX
+        // positional writes ignore the offset of append-mode descriptors on Linux
+        if (m_append)
+        {
+            return output_stream::write_bytes_gather(inputs);
+        }
+
+        const int fd = ::fileno(m_handle);
+
+        // pending CRT output has to land first, then the handle is moved past the written block
+        [[maybe_unused]] const auto rc = std::fflush(m_handle);
+        REIO_ASSERT(rc == 0, "failed to flush the file before a vectored write");
+
+        const auto written = DoTransferVectored<true>(fd, m_position, inputs);
+
+        DoSeek<seek_origin::begin>(m_handle, m_position + written);
+        m_position += written;
+        m_length = std::max(m_length, m_position);
+
+        return written;
+#else
+        return output_stream::write_bytes_gather(inputs);
+#endif
+    }
 }
@@ -1,38 +1,9 @@
 #include "reio/streams/memory_streams.hpp"
+#include "./seek_helpers.hpp"
 
 namespace reio
 {
 
-    template<seek_origin Origin>
-    [[nodiscard]] constexpr int64_t
-    DoCalcPosition(
-            [[maybe_unused]] int64_t length,
-            [[maybe_unused]] int64_t position,
-            [[maybe_unused]] int64_t offset)
-    {
-        if constexpr (Origin == seek_origin::begin)
-        {
-            REIO_ASSERT(offset >= 0, "can't seek negative offset from the beginning of the underlying buffer");
-            REIO_ASSERT(offset < length, "can't seek offset from the beginning beyond the underlying buffer");
-            return offset;
-        }
-        if constexpr (Origin == seek_origin::current)
-        {
-            const auto new_position = position + offset;
-            REIO_ASSERT(new_position >= 0, "can't seek offset below the underlying buffer's start");
-            REIO_ASSERT(new_position <= length, "can't seek offset beyond the underlying buffer's end");
-            return new_position;
-        }
-        if constexpr (Origin == seek_origin::end)
-        {
-            REIO_ASSERT(offset <= 0, "can't seek positive offset from the end of the underlying buffer");
-            REIO_ASSERT(offset > -length, "can't seek offset from the beginning beyond the underlying buffer");
-            return length + offset;
-        }
-        REIO_FAIL("unhandled seek origin", __FILE__, __LINE__, _REIO_FUNC_);
-//        return std::numeric_limits<int64_t>::min();
-    }
-
     memory_input_stream::memory_input_stream(weak_buffer source_view, base_allocator* alloc)
         : m_buffer{ source_view, alloc }
         , m_position{ 0u }
@@ -134,6 +105,159 @@ namespace reio
         return read_length;
     }
 
+    ///
+    /// @brief      Borrow bytes straight from the underlying buffer.
+    /// @param      size    Number of bytes to borrow.
+    /// @return     View of up to @c size bytes, valid for as long as the stream's data is.
+    ///
+    std::optional<weak_buffer>
+    memory_input_stream::try_read_view(std::size_t size)
+    {
+        const auto remaining_length = static_cast<int64_t>(m_buffer.length()) - m_position;
+        const auto view_length = std::min<int64_t>(static_cast<int64_t>(size), remaining_length);
+
+        const auto view = weak_buffer{ m_buffer.data() + m_position, static_cast<std::size_t>(view_length) };
+        m_position += view_length;
+
+        return view;
+    }
+
+    int64_t
+    memory_input_stream::size() const
+    {
+        return static_cast<int64_t>(m_buffer.length());
+    }
+
+    int64_t
+    memory_input_stream::read_at(int64_t offset, weak_buffer output) const
+    {
+        return DoReadBlockAt(m_buffer.view(), offset, output);
+    }
+
+    std::optional<weak_buffer>
+    memory_input_stream::view_at(int64_t offset, std::size_t size) const
+    {
+        return DoViewBlockAt(m_buffer.view(), offset, size);
+    }
+
+
+    view_input_stream::view_input_stream(weak_buffer source_view)
+        : m_view{ source_view }
+        , m_position{ 0 }
+    {
+        REIO_ASSERT(source_view.data() != nullptr, "can't initialize view input stream with a null view");
+        REIO_ASSERT(source_view.length() != 0u, "can't initialize view input stream with an empty view");
+    }
+
+    view_input_stream::~view_input_stream() = default;
+
+    view_input_stream::view_input_stream(view_input_stream &&other) noexcept
+        : m_view{ std::move(other.m_view) }
+        , m_position{ std::exchange(other.m_position, 0) }
+    {
+
+    }
+
+    view_input_stream &
+    view_input_stream::operator=(view_input_stream &&other) noexcept
+    {
+        if (this != &other) {
+            m_view = std::move(other.m_view);
+            m_position = std::exchange(other.m_position, 0);
+        }
+
+        return *this;
+    }
+
+    weak_buffer
+    view_input_stream::view() const noexcept
+    {
+        return m_view;
+    }
+
+    int64_t
+    view_input_stream::position()
+    {
+        return m_position;
+    }
+
+    int64_t
+    view_input_stream::length()
+    {
+        return static_cast<int64_t>(m_view.length());
+    }
+
+    void
+    view_input_stream::seek_begin(int64_t offset)
+    {
+        const auto length_ = static_cast<int64_t>(m_view.length());
+        m_position = DoCalcPosition<seek_origin::begin>(length_, m_position, offset);
+    }
+
+    void
+    view_input_stream::seek_current(int64_t offset)
+    {
+        const auto length_ = static_cast<int64_t>(m_view.length());
+        m_position = DoCalcPosition<seek_origin::current>(length_, m_position, offset);
+    }
+
+    void
+    view_input_stream::seek_end(int64_t offset)
+    {
+        const auto length_ = static_cast<int64_t>(m_view.length());
+        m_position = DoCalcPosition<seek_origin::end>(length_, m_position, offset);
+    }
+
+    int64_t
+    view_input_stream::read_bytes(weak_buffer output)
+    {
+        REIO_ASSERT(output.data() != nullptr, "can't read from input streams into nullptr");
+        REIO_ASSERT(output.length() > 0, "can't read zero bytes from input streams");
+
+        const auto remaining_length = static_cast<int64_t>(m_view.length()) - m_position;
+        const auto read_length = std::min<int64_t>(output.length(), remaining_length);
+
+        std::copy_n(m_view.data() + m_position, read_length, output.data());
+        m_position += read_length;
+
+        return read_length;
+    }
+
+    ///
+    /// @brief      Borrow bytes straight from the viewed block.
+    /// @param      size    Number of bytes to borrow.
+    /// @return     View of up to @c size bytes, valid for as long as the viewed block is.
+    ///
+    std::optional<weak_buffer>
+    view_input_stream::try_read_view(std::size_t size)
+    {
+        const auto remaining_length = static_cast<int64_t>(m_view.length()) - m_position;
+        const auto view_length = std::min<int64_t>(static_cast<int64_t>(size), remaining_length);
+
+        const auto view = weak_buffer{ m_view.data() + m_position, static_cast<std::size_t>(view_length) };
+        m_position += view_length;
+
+        return view;
+    }
+
+    int64_t
+    view_input_stream::size() const
+    {
+        return static_cast<int64_t>(m_view.length());
+    }
+
+    int64_t
+    view_input_stream::read_at(int64_t offset, weak_buffer output) const
+    {
+        return DoReadBlockAt(m_view, offset, output);
+    }
+
+    std::optional<weak_buffer>
+    view_input_stream::view_at(int64_t offset, std::size_t size) const
+    {
+        return DoViewBlockAt(m_view, offset, size);
+    }
+
 
     memory_output_stream::memory_output_stream(base_allocator *alloc)
         : m_buffer{ alloc }
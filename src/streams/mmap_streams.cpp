@@ -0,0 +1,271 @@
+#include "reio/streams/mmap_streams.hpp"
+#include "./seek_helpers.hpp"
+
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace reio
+{
+
+    static constexpr int mmap_advice_to_posix(mmap_advice advice) noexcept
+    {
+        switch (advice)
+        {
+            case mmap_advice::normal:       return MADV_NORMAL;
+            case mmap_advice::sequential:   return MADV_SEQUENTIAL;
+            case mmap_advice::random:       return MADV_RANDOM;
+            case mmap_advice::willneed:     return MADV_WILLNEED;
+            case mmap_advice::dontneed:     return MADV_DONTNEED;
+        }
+        return MADV_NORMAL;
+    }
+
+    ///
+    /// @brief      Initialize stream by mapping a physical file.
+    ///
+    /// Empty files are not mapped at all, and produce an empty stream.
+    ///
+    /// @param      path            Path to the file which should be mapped.
+    /// @param      options         Mapping options.
+    /// @throw      io_exception    If the file can't be opened or mapped.
+    ///
+    mmap_input_stream::mmap_input_stream(std::string_view path, mmap_options options)
+    {
+        const int fd = ::open(path.data(), O_RDONLY | O_CLOEXEC);
+        REIO_ASSERT(fd != -1, "failed to open a file for mmap stream");
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            REIO_FAIL("failed to get the size of a file for mmap stream", __FILE__, __LINE__, _REIO_FUNC_);
+        }
+
+        m_length = static_cast<int64_t>(info.st_size);
+        if (m_length == 0)
+        {
+            ::close(fd);
+            return;
+        }
+
+        int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        if (options.m_populate)
+        {
+            flags |= MAP_POPULATE;
+        }
+#endif
+
+        void* mapping = ::mmap(nullptr, static_cast<std::size_t>(m_length), PROT_READ, flags, fd, 0);
+
+        // the mapping keeps its own reference to the file
+        ::close(fd);
+
+        REIO_ASSERT(mapping != MAP_FAILED, "failed to map a file for mmap stream");
+        m_data = static_cast<byte*>(mapping);
+
+        if (options.m_advice != mmap_advice::normal)
+        {
+            // only a hint, so failures are ignored rather than leaking the mapping on a throw
+            ::madvise(m_data, static_cast<std::size_t>(m_length), mmap_advice_to_posix(options.m_advice));
+        }
+    }
+
+    mmap_input_stream::~mmap_input_stream()
+    {
+        do_unmap();
+    }
+
+    mmap_input_stream::mmap_input_stream(mmap_input_stream &&other) noexcept
+        : m_data{ std::exchange(other.m_data, nullptr) }
+        , m_length{ std::exchange(other.m_length, 0) }
+        , m_position{ std::exchange(other.m_position, 0) }
+    {
+
+    }
+
+    mmap_input_stream &
+    mmap_input_stream::operator=(mmap_input_stream &&other) noexcept
+    {
+        if (this != &other) {
+            do_unmap();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_length = std::exchange(other.m_length, 0);
+            m_position = std::exchange(other.m_position, 0);
+        }
+
+        return *this;
+    }
+
+    ///
+    /// @brief      Get a view of the entire mapping.
+    /// @return     Read-only view over all bytes of the file.
+    ///
+    weak_buffer
+    mmap_input_stream::view() const noexcept
+    {
+        return { m_data, static_cast<std::size_t>(m_length) };
+    }
+
+    ///
+    /// @brief      Get a view over a part of the mapping, without copying it.
+    ///
+    /// @param      offset          Number of bytes from the start of the file.
+    /// @param      size            Number of bytes in the resulting view.
+    /// @throw      io_exception    When @c offset or @c offset + @c size are out of bounds.
+    ///
+    /// @return     Read-only view over @c size bytes of the file starting at @c offset.
+    ///
+    weak_buffer
+    mmap_input_stream::view(int64_t offset, int64_t size) const
+    {
+        REIO_ASSERT(offset >= 0 && offset <= m_length, "view offset out of mapping bounds");
+        REIO_ASSERT(size >= 0 && size <= m_length - offset, "view size bigger than mapping length");
+        return { m_data + offset, static_cast<std::size_t>(size) };
+    }
+
+    ///
+    /// @brief      Hint the kernel about the access pattern for the whole mapping.
+    /// @param      advice          Access pattern hint.
+    /// @throw      io_exception    If the kernel rejected the hint.
+    ///
+    void
+    mmap_input_stream::advise(mmap_advice advice)
+    {
+        advise(advice, 0, m_length);
+    }
+
+    ///
+    /// @brief      Hint the kernel about the access pattern for a part of the mapping.
+    ///
+    /// The range is extended to page boundaries as required by @c madvise.
+    ///
+    /// @param      advice          Access pattern hint.
+    /// @param      offset          Number of bytes from the start of the file.
+    /// @param      size            Number of bytes in the range.
+    /// @throw      io_exception    When the range is out of bounds, or the kernel rejected the hint.
+    ///
+    void
+    mmap_input_stream::advise(mmap_advice advice, int64_t offset, int64_t size)
+    {
+        REIO_ASSERT(offset >= 0 && offset <= m_length, "advised offset out of mapping bounds");
+        REIO_ASSERT(size >= 0 && size <= m_length - offset, "advised size bigger than mapping length");
+
+        if (size == 0)
+        {
+            return;
+        }
+
+        const auto page_size = static_cast<int64_t>(::sysconf(_SC_PAGESIZE));
+        const auto aligned_offset = offset - offset % page_size;
+        const auto aligned_size = size + (offset - aligned_offset);
+
+        [[maybe_unused]] const auto rc = ::madvise(m_data + aligned_offset,
+                                                   static_cast<std::size_t>(aligned_size),
+                                                   mmap_advice_to_posix(advice));
+        REIO_ASSERT(rc == 0, "failed to advise on mapping access pattern");
+    }
+
+    int64_t
+    mmap_input_stream::position()
+    {
+        return m_position;
+    }
+
+    int64_t
+    mmap_input_stream::length()
+    {
+        return m_length;
+    }
+
+    void
+    mmap_input_stream::seek_begin(int64_t offset)
+    {
+        m_position = DoCalcPosition<seek_origin::begin>(m_length, m_position, offset);
+    }
+
+    void
+    mmap_input_stream::seek_current(int64_t offset)
+    {
+        m_position = DoCalcPosition<seek_origin::current>(m_length, m_position, offset);
+    }
+
+    void
+    mmap_input_stream::seek_end(int64_t offset)
+    {
+        m_position = DoCalcPosition<seek_origin::end>(m_length, m_position, offset);
+    }
+
+    int64_t
+    mmap_input_stream::read_bytes(weak_buffer output)
+    {
+        REIO_ASSERT(output.data() != nullptr, "can't read from input streams into nullptr");
+        REIO_ASSERT(output.length() > 0, "can't read zero bytes from input streams");
+
+        const auto remaining_length = m_length - m_position;
+        const auto read_length = std::min<int64_t>(static_cast<int64_t>(output.length()), remaining_length);
+
+        std::copy_n(m_data + m_position, read_length, output.data());
+        m_position += read_length;
+
+        return read_length;
+    }
+
+    ///
+    /// @brief      Borrow bytes straight from the underlying mapping.
+    /// @param      size    Number of bytes to borrow.
+    /// @return     View of up to @c size bytes, valid for as long as the stream's data is.
+    ///
+    std::optional<weak_buffer>
+    mmap_input_stream::try_read_view(std::size_t size)
+    {
+        const auto remaining_length = m_length - m_position;
+        const auto view_length = std::min<int64_t>(static_cast<int64_t>(size), remaining_length);
+
+        const auto view = weak_buffer{ m_data + m_position, static_cast<std::size_t>(view_length) };
+        m_position += view_length;
+
+        return view;
+    }
+
+    int64_t
+    mmap_input_stream::size() const
+    {
+        return m_length;
+    }
+
+    int64_t
+    mmap_input_stream::read_at(int64_t offset, weak_buffer output) const
+    {
+        return DoReadBlockAt(view(), offset, output);
+    }
+
+    std::optional<weak_buffer>
+    mmap_input_stream::view_at(int64_t offset, std::size_t size) const
+    {
+        return DoViewBlockAt(view(), offset, size);
+    }
+
+    void
+    mmap_input_stream::do_unmap() noexcept
+    {
+        if (m_data == nullptr)
+        {
+            return;
+        }
+
+        [[maybe_unused]] const auto rc = ::munmap(m_data, static_cast<std::size_t>(m_length));
+
+#ifdef _DEBUG
+        if (rc != 0)
+        {
+            std::fputs("warning: munmap reported failure in ~mmap_input_stream", stderr);
+        }
+#endif
+    }
+
+}
@@ -0,0 +1,262 @@
+#include "reio/streams/parallel_reader.hpp"
+
+#include <algorithm>
+#include <utility>
+
+
+namespace reio
+{
+
+    ///
+    /// @brief      Initialize a reader, and start its workers.
+    ///
+    /// @param      source          Source to read from.
+    /// @param      options         Chunk size and number of workers.
+    /// @param      alloc           Allocator for per-worker buffers.
+    /// @throw      io_exception    If @c source is NULL, or chunk size is zero.
+    ///
+    parallel_reader::parallel_reader(const random_access_source* source,
+                                     parallel_read_options options,
+                                     base_allocator* alloc)
+        : m_source{ source }, m_options{ options }, m_allocator{ alloc }
+        , m_generation{ 0u }, m_busy_workers{ 0u }, m_stopping{ false }
+        , m_callback{ nullptr }, m_range_begin{ 0 }, m_range_end{ 0 }
+        , m_next_chunk{ 0 }, m_delivered{ 0 }, m_failed{ false }
+    {
+        REIO_ASSERT(source != nullptr, "can't initialize parallel reader with a null source");
+        REIO_ASSERT(options.m_chunk_size > 0u, "chunk size must be positive");
+
+        if (m_options.m_concurrency == 0u)
+        {
+            m_options.m_concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        m_workers.reserve(m_options.m_concurrency);
+        try
+        {
+            for (std::size_t i = 0u; i < m_options.m_concurrency; i++)
+            {
+                m_workers.emplace_back(&parallel_reader::worker_main, this);
+            }
+        }
+        catch (...)
+        {
+            // the destructor doesn't run, and joinable threads would terminate the process
+            stop_workers();
+            throw;
+        }
+    }
+
+    parallel_reader::~parallel_reader() noexcept
+    {
+        stop_workers();
+    }
+
+    ///
+    /// @brief      Get the source which is read by the reader.
+    /// @return     Non-owned source.
+    ///
+    const random_access_source*
+    parallel_reader::source() const noexcept
+    {
+        return m_source;
+    }
+
+    ///
+    /// @brief      Get options of the reader.
+    /// @return     Options, with the actual number of workers.
+    ///
+    const parallel_read_options&
+    parallel_reader::options() const noexcept
+    {
+        return m_options;
+    }
+
+    ///
+    /// @brief      Get the number of worker threads.
+    /// @return     Number of chunks which can be read at the same time.
+    ///
+    std::size_t
+    parallel_reader::concurrency() const noexcept
+    {
+        return m_workers.size();
+    }
+
+    ///
+    /// @brief      Read a range of the source in chunks, and wait until all of them are handled.
+    ///
+    /// Chunks start at @c offset and are @c m_chunk_size long, except for the last one.
+    /// A range which goes past the end of the source is clamped.
+    ///
+    /// @param      offset          Offset of the first byte to read.
+    /// @param      size            Number of bytes to read.
+    /// @param      callback        Function receiving every chunk with its offset.
+    /// @throw      io_exception    If the range is invalid.
+    /// @throw      ...             First exception thrown by the source or the callback.
+    ///
+    /// @return     Number of bytes handed to the callback.
+    ///
+    int64_t
+    parallel_reader::read(int64_t offset, int64_t size, const chunk_callback& callback)
+    {
+        REIO_ASSERT(offset >= 0, "can't read at a negative offset");
+        REIO_ASSERT(size >= 0, "can't read a negative number of bytes");
+        REIO_ASSERT(static_cast<bool>(callback), "can't read without a callback");
+
+        // clamped before adding, so sizes meaning "to the end" like INT64_MAX can't overflow
+        const auto source_size = m_source->size();
+        if (offset >= source_size || size == 0)
+        {
+            return 0;
+        }
+        const auto end = offset + std::min(size, source_size - offset);
+
+        std::unique_lock lock{ m_mutex };
+
+        m_callback = &callback;
+        m_range_begin = offset;
+        m_range_end = end;
+        m_next_chunk.store(0, std::memory_order_relaxed);
+        m_delivered.store(0, std::memory_order_relaxed);
+        m_failed.store(false, std::memory_order_relaxed);
+        m_error = nullptr;
+
+        m_busy_workers = m_workers.size();
+        m_generation++;
+        m_wake.notify_all();
+
+        m_done.wait(lock, [this]() { return m_busy_workers == 0u; });
+        m_callback = nullptr;
+
+        if (m_error)
+        {
+            std::rethrow_exception(std::exchange(m_error, nullptr));
+        }
+
+        return m_delivered.load(std::memory_order_relaxed);
+    }
+
+    ///
+    /// @brief      Read the whole source in chunks, and wait until all of them are handled.
+    /// @param      callback    Function receiving every chunk with its offset.
+    /// @return     Number of bytes handed to the callback.
+    ///
+    int64_t
+    parallel_reader::read_all(const chunk_callback& callback)
+    {
+        return read(0, m_source->size(), callback);
+    }
+
+    void
+    parallel_reader::stop_workers() noexcept
+    {
+        {
+            std::lock_guard lock{ m_mutex };
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void
+    parallel_reader::worker_main()
+    {
+        // allocated on first use, since sources providing views don't need it
+        owning_buffer scratch{ m_allocator };
+        uint64_t generation = 0u;
+
+        while (true)
+        {
+            {
+                std::unique_lock lock{ m_mutex };
+                m_wake.wait(lock, [this, generation]() { return m_stopping || m_generation != generation; });
+
+                if (m_stopping)
+                {
+                    return;
+                }
+                generation = m_generation;
+            }
+
+            read_chunks(scratch);
+
+            {
+                std::lock_guard lock{ m_mutex };
+                if (--m_busy_workers == 0u)
+                {
+                    m_done.notify_all();
+                }
+            }
+        }
+    }
+
+    void
+    parallel_reader::read_chunks(owning_buffer& scratch)
+    {
+        const auto chunk_size = static_cast<int64_t>(m_options.m_chunk_size);
+
+        while (!m_failed.load(std::memory_order_relaxed))
+        {
+            const auto offset = m_range_begin + m_next_chunk.fetch_add(1, std::memory_order_relaxed) * chunk_size;
+            if (offset >= m_range_end)
+            {
+                return;
+            }
+
+            try
+            {
+                const auto size = static_cast<std::size_t>(std::min(chunk_size, m_range_end - offset));
+                m_delivered.fetch_add(read_chunk(scratch, offset, size), std::memory_order_relaxed);
+            }
+            catch (...)
+            {
+                std::lock_guard lock{ m_mutex };
+                if (!m_error)
+                {
+                    m_error = std::current_exception();
+                }
+                m_failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    int64_t
+    parallel_reader::read_chunk(owning_buffer& scratch, int64_t offset, std::size_t size)
+    {
+        if (const auto view = m_source->view_at(offset, size); view.has_value() && view->length() > 0u)
+        {
+            (*m_callback)(offset, *view);
+            return static_cast<int64_t>(view->length());
+        }
+
+        if (scratch.capacity() < m_options.m_chunk_size)
+        {
+            scratch = owning_buffer{ m_options.m_chunk_size, m_allocator };
+        }
+
+        // positional reads may be short, e.g. when interrupted
+        std::size_t filled = 0u;
+        while (filled < size)
+        {
+            const auto read = m_source->read_at(offset + static_cast<int64_t>(filled),
+                                                weak_buffer{ scratch.data() + filled, size - filled });
+            if (read <= 0)
+            {
+                break;
+            }
+            filled += static_cast<std::size_t>(read);
+        }
+
+        if (filled > 0u)
+        {
+            (*m_callback)(offset, weak_buffer{ scratch.data(), filled });
+        }
+
+        return static_cast<int64_t>(filled);
+    }
+
+}
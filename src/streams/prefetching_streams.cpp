@@ -0,0 +1,326 @@
+#include "reio/streams/prefetching_streams.hpp"
+
+#include <algorithm>
+#include <utility>
+
+
+namespace reio
+{
+
+    prefetching_input_stream::prefetching_input_stream(input_stream* source,
+                                                       std::size_t slot_size,
+                                                       std::size_t slot_count,
+                                                       base_allocator* alloc)
+        : m_source{ source }
+        , m_storage{ alloc }
+        , m_slot_size{ slot_size }
+        , m_slot_lengths(slot_count, 0u)
+        , m_position{ 0 }
+        , m_cursor{ 0u }
+        , m_head_length{ 0u }
+        , m_has_head{ false }
+        , m_head{ 0u }
+        , m_ready{ 0u }
+        , m_fill_position{ 0 }
+        , m_reading{ false }
+        , m_eof{ false }
+        , m_stopping{ false }
+    {
+        REIO_ASSERT(source != nullptr, "can't initialize prefetching input stream with a null source");
+        REIO_ASSERT(slot_size != 0u, "can't initialize prefetching input stream with empty slots");
+        REIO_ASSERT(slot_count >= 2u, "prefetching input stream needs at least two slots");
+
+        m_storage = owning_buffer{ slot_size * slot_count, alloc };
+        m_position = source->position();
+        m_fill_position = m_position;
+
+        m_worker = std::thread{ &prefetching_input_stream::worker_main, this };
+    }
+
+    prefetching_input_stream::~prefetching_input_stream()
+    {
+        {
+            std::lock_guard lock{ m_mutex };
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_worker.join();
+    }
+
+    ///
+    /// @brief      Get the wrapped stream.
+    /// @return     Pointer to the stream which is used as a data source.
+    ///
+    input_stream*
+    prefetching_input_stream::source() const noexcept
+    {
+        return m_source;
+    }
+
+    ///
+    /// @brief      Get the maximum number of bytes which are read by the worker at once.
+    /// @return     Capacity (in bytes) of every slot.
+    ///
+    std::size_t
+    prefetching_input_stream::slot_size() const noexcept
+    {
+        return m_slot_size;
+    }
+
+    ///
+    /// @brief      Get the number of slots in the ring.
+    /// @return     Maximum number of blocks which are buffered at once.
+    ///
+    std::size_t
+    prefetching_input_stream::slot_count() const noexcept
+    {
+        return m_slot_lengths.size();
+    }
+
+    int64_t
+    prefetching_input_stream::position()
+    {
+        return m_position;
+    }
+
+    int64_t
+    prefetching_input_stream::length()
+    {
+        const auto lock = pause();
+        return m_source->length();
+    }
+
+    void
+    prefetching_input_stream::seek_begin(int64_t offset)
+    {
+        if (try_seek_within(offset))
+        {
+            return;
+        }
+
+        const auto lock = pause();
+        m_source->seek_begin(offset);
+        restart(offset);
+    }
+
+    void
+    prefetching_input_stream::seek_current(int64_t offset)
+    {
+        const auto target = m_position + offset;
+        if (try_seek_within(target))
+        {
+            return;
+        }
+
+        // the wrapped stream is ahead of the consumer, so the offset has
+        // to be rebased to keep its own seek checks intact
+        const auto lock = pause();
+        m_source->seek_current(target - m_fill_position);
+        restart(target);
+    }
+
+    void
+    prefetching_input_stream::seek_end(int64_t offset)
+    {
+        const auto lock = pause();
+        m_source->seek_end(offset);
+        restart(m_source->position());
+    }
+
+    int64_t
+    prefetching_input_stream::read_bytes(weak_buffer output)
+    {
+        REIO_ASSERT(output.data() != nullptr, "can't read from input streams into nullptr");
+        REIO_ASSERT(output.length() > 0, "can't read zero bytes from input streams");
+
+        auto dest = output.data();
+        auto remaining = output.length();
+
+        // bytes which were already copied mustn't be lost, so a failure is reported by the next call
+        while (remaining > 0u && acquire_head(remaining == output.length()))
+        {
+            const auto served = std::min(m_head_length - m_cursor, remaining);
+            std::copy_n(slot_data(m_head) + m_cursor, served, dest);
+
+            m_cursor += served;
+            m_position += static_cast<int64_t>(served);
+            dest += served;
+            remaining -= served;
+        }
+
+        return static_cast<int64_t>(output.length() - remaining);
+    }
+
+    int64_t
+    prefetching_input_stream::read_byte()
+    {
+        if (!acquire_head())
+        {
+            return -1;
+        }
+
+        m_position++;
+        return static_cast<int64_t>(slot_data(m_head)[m_cursor++]);
+    }
+
+    bool
+    prefetching_input_stream::try_seek_within(int64_t target) noexcept
+    {
+        const auto head_start = m_position - static_cast<int64_t>(m_cursor);
+        const auto head_end = head_start + static_cast<int64_t>(m_head_length);
+        if (!m_has_head || target < head_start || target >= head_end)
+        {
+            return false;
+        }
+
+        m_cursor = static_cast<std::size_t>(target - head_start);
+        m_position = target;
+        return true;
+    }
+
+    ///
+    /// @brief      Wait until the worker isn't reading, and keep it from starting another read.
+    /// @return     Lock which keeps the worker paused while it's held.
+    ///
+    std::unique_lock<std::mutex>
+    prefetching_input_stream::pause()
+    {
+        std::unique_lock lock{ m_mutex };
+        m_changed.wait(lock, [this]() { return !m_reading; });
+        return lock;
+    }
+
+    ///
+    /// @brief      Drop all prefetched slots, and start prefetching again from the wrapped stream's position.
+    ///
+    /// Must be called while the worker is paused.
+    ///
+    /// @param      position    Position of the wrapped stream.
+    ///
+    void
+    prefetching_input_stream::restart(int64_t position) noexcept
+    {
+        m_position = position;
+        m_cursor = 0u;
+        m_head_length = 0u;
+        m_has_head = false;
+
+        m_head = 0u;
+        m_ready = 0u;
+        m_fill_position = position;
+        m_eof = false;
+        m_error = nullptr;
+
+        m_wake.notify_one();
+    }
+
+    ///
+    /// @brief      Make sure that the head slot has unread bytes, waiting for the worker if needed.
+    /// @param      report      Whether to rethrow a failure, or keep it for a later call.
+    /// @throw      ...         Failure of the wrapped stream, reported once.
+    /// @return     Whether there's anything left to read.
+    ///
+    bool
+    prefetching_input_stream::acquire_head(bool report)
+    {
+        if (m_has_head)
+        {
+            if (m_cursor < m_head_length)
+            {
+                return true;
+            }
+            release_head();
+        }
+
+        std::unique_lock lock{ m_mutex };
+        m_changed.wait(lock, [this]() { return m_ready > 0u || m_eof || m_error; });
+
+        if (m_ready > 0u)
+        {
+            m_head_length = m_slot_lengths[m_head];
+            m_has_head = true;
+            return true;
+        }
+
+        if (m_error && report)
+        {
+            // the worker retries from where it failed on the next read
+            m_wake.notify_one();
+            std::rethrow_exception(std::exchange(m_error, nullptr));
+        }
+
+        return false;
+    }
+
+    void
+    prefetching_input_stream::release_head()
+    {
+        {
+            std::lock_guard lock{ m_mutex };
+            m_head = (m_head + 1u) % m_slot_lengths.size();
+            m_ready--;
+        }
+        m_wake.notify_one();
+
+        m_cursor = 0u;
+        m_head_length = 0u;
+        m_has_head = false;
+    }
+
+    void
+    prefetching_input_stream::worker_main()
+    {
+        const auto slot_count = m_slot_lengths.size();
+        std::unique_lock lock{ m_mutex };
+
+        while (true)
+        {
+            m_wake.wait(lock, [this, slot_count]() {
+                return m_stopping || (m_ready < slot_count && !m_eof && !m_error);
+            });
+
+            if (m_stopping)
+            {
+                return;
+            }
+
+            // the slot isn't visible to the consumer until m_ready is bumped,
+            // so it's filled without holding the lock
+            const auto index = (m_head + m_ready) % slot_count;
+            m_reading = true;
+            lock.unlock();
+
+            int64_t read = 0;
+            std::exception_ptr error;
+            try
+            {
+                read = m_source->read_bytes(weak_buffer{ slot_data(index), m_slot_size });
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            m_reading = false;
+
+            if (error)
+            {
+                m_error = error;
+            }
+            else if (read <= 0)
+            {
+                m_eof = true;
+            }
+            else
+            {
+                m_slot_lengths[index] = static_cast<std::size_t>(read);
+                m_fill_position += read;
+                m_ready++;
+            }
+
+            m_changed.notify_all();
+        }
+    }
+
+}
@@ -0,0 +1,93 @@
+#include "reio/streams/random_access.hpp"
+#include "./seek_helpers.hpp"
+
+
+namespace reio
+{
+
+    std::optional<weak_buffer>
+    random_access_source::view_at([[maybe_unused]] int64_t offset, [[maybe_unused]] std::size_t size) const
+    {
+        return std::nullopt;
+    }
+
+
+    ///
+    /// @brief      Initialize a cursor over a source.
+    ///
+    /// @param      source          Source to read from.
+    /// @param      start           Initial position of the cursor.
+    /// @throw      io_exception    If @c source is NULL, or @c start is out of its bounds.
+    ///
+    cursor_input_stream::cursor_input_stream(const random_access_source* source, int64_t start)
+        : m_source{ source }, m_position{ 0 }
+    {
+        REIO_ASSERT(source != nullptr, "can't initialize cursor with a null source");
+        m_position = DoCalcPosition<seek_origin::current>(source->size(), 0, start);
+    }
+
+    ///
+    /// @brief      Get the source which is read by the cursor.
+    /// @return     Non-owned source.
+    ///
+    const random_access_source*
+    cursor_input_stream::source() const noexcept
+    {
+        return m_source;
+    }
+
+    int64_t
+    cursor_input_stream::position()
+    {
+        return m_position;
+    }
+
+    int64_t
+    cursor_input_stream::length()
+    {
+        return m_source->size();
+    }
+
+    void
+    cursor_input_stream::seek_begin(int64_t offset)
+    {
+        m_position = DoCalcPosition<seek_origin::begin>(m_source->size(), m_position, offset);
+    }
+
+    void
+    cursor_input_stream::seek_current(int64_t offset)
+    {
+        m_position = DoCalcPosition<seek_origin::current>(m_source->size(), m_position, offset);
+    }
+
+    void
+    cursor_input_stream::seek_end(int64_t offset)
+    {
+        m_position = DoCalcPosition<seek_origin::end>(m_source->size(), m_position, offset);
+    }
+
+    int64_t
+    cursor_input_stream::read_bytes(weak_buffer output)
+    {
+        REIO_ASSERT(output.data() != nullptr, "can't read from input streams into nullptr");
+        REIO_ASSERT(output.length() > 0, "can't read zero bytes from input streams");
+
+        const auto read = m_source->read_at(m_position, output);
+        m_position += read;
+
+        return read;
+    }
+
+    std::optional<weak_buffer>
+    cursor_input_stream::try_read_view(std::size_t size)
+    {
+        const auto view = m_source->view_at(m_position, size);
+        if (view.has_value())
+        {
+            m_position += static_cast<int64_t>(view->length());
+        }
+
+        return view;
+    }
+
+}
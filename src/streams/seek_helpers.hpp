@@ -0,0 +1,94 @@
+#ifndef REIO_SEEK_HELPERS_HPP
+#define REIO_SEEK_HELPERS_HPP
+
+#include "reio/asserts.hpp"
+#include "reio/types.hpp"
+#include "reio/buffers/weak_buffer.hpp"
+#include "reio/streams/streams.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace reio
+{
+
+    ///
+    /// @brief      Validate and calculate a new cursor position within a block of known length.
+    ///
+    /// Shared by all streams which are backed by a contiguous in-memory block,
+    /// so that they have exactly the same seeking semantics.
+    ///
+    template<seek_origin Origin>
+    [[nodiscard]] constexpr int64_t
+    DoCalcPosition(
+            [[maybe_unused]] int64_t length,
+            [[maybe_unused]] int64_t position,
+            [[maybe_unused]] int64_t offset)
+    {
+        if constexpr (Origin == seek_origin::begin)
+        {
+            REIO_ASSERT(offset >= 0, "can't seek negative offset from the beginning of the underlying buffer");
+            REIO_ASSERT(offset < length, "can't seek offset from the beginning beyond the underlying buffer");
+            return offset;
+        }
+        if constexpr (Origin == seek_origin::current)
+        {
+            const auto new_position = position + offset;
+            REIO_ASSERT(new_position >= 0, "can't seek offset below the underlying buffer's start");
+            REIO_ASSERT(new_position <= length, "can't seek offset beyond the underlying buffer's end");
+            return new_position;
+        }
+        if constexpr (Origin == seek_origin::end)
+        {
+            REIO_ASSERT(offset <= 0, "can't seek positive offset from the end of the underlying buffer");
+            REIO_ASSERT(offset > -length, "can't seek offset from the beginning beyond the underlying buffer");
+            return length + offset;
+        }
+        REIO_FAIL("unhandled seek origin", __FILE__, __LINE__, _REIO_FUNC_);
+//        return std::numeric_limits<int64_t>::min();
+    }
+
+    ///
+    /// @brief      Copy bytes at an offset within a contiguous in-memory block,
+    ///             as done by @c random_access_source::read_at.
+    ///
+    inline int64_t
+    DoReadBlockAt(weak_buffer block, int64_t offset, weak_buffer output)
+    {
+        REIO_ASSERT(offset >= 0, "can't read at a negative offset");
+        REIO_ASSERT(output.data() != nullptr, "can't read into nullptr");
+        REIO_ASSERT(output.length() > 0, "can't read zero bytes");
+
+        if (offset >= static_cast<int64_t>(block.length()))
+        {
+            return 0;
+        }
+
+        const auto read_length = std::min(output.length(), block.length() - static_cast<std::size_t>(offset));
+        std::memcpy(output.data(), block.data() + offset, read_length);
+
+        return static_cast<int64_t>(read_length);
+    }
+
+    ///
+    /// @brief      Get a view at an offset within a contiguous in-memory block,
+    ///             as done by @c random_access_source::view_at.
+    ///
+    inline weak_buffer
+    DoViewBlockAt(weak_buffer block, int64_t offset, std::size_t size)
+    {
+        REIO_ASSERT(offset >= 0, "can't view at a negative offset");
+
+        if (offset >= static_cast<int64_t>(block.length()))
+        {
+            return { block.data() + block.length(), 0u };
+        }
+
+        const auto view_length = std::min(size, block.length() - static_cast<std::size_t>(offset));
+        return { block.data() + offset, view_length };
+    }
+
+}
+
+#endif //REIO_SEEK_HELPERS_HPP
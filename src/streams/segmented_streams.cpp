@@ -0,0 +1,226 @@
+#include "reio/streams/segmented_streams.hpp"
+#include "./seek_helpers.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace reio
+{
+
+    ///
+    /// @brief      Initialize empty stream, without allocating any segments yet.
+    ///
+    /// @param      segment_size    Size (in bytes) of every segment.
+    /// @param      alloc           Allocator which should be used for segments.
+    /// @throw      io_exception    If @c segment_size is zero, or @c alloc is NULL.
+    ///
+    segmented_output_stream::segmented_output_stream(std::size_t segment_size, base_allocator* alloc)
+        : m_allocator{ alloc }, m_segment_size{ segment_size }
+        , m_segments{}, m_length{ 0 }, m_position{ 0 }
+    {
+        REIO_ASSERT(segment_size > 0u, "segment size must be positive");
+        REIO_ASSERT(alloc != nullptr, "segmented stream can't have null allocator");
+    }
+
+    segmented_output_stream::~segmented_output_stream()
+    {
+        release_segments();
+    }
+
+    segmented_output_stream::segmented_output_stream(segmented_output_stream&& other) noexcept
+        : m_allocator{ other.m_allocator }, m_segment_size{ other.m_segment_size }
+        , m_segments{ std::move(other.m_segments) }
+        , m_length{ std::exchange(other.m_length, 0) }
+        , m_position{ std::exchange(other.m_position, 0) }
+    {
+        other.m_segments.clear();
+    }
+
+    segmented_output_stream&
+    segmented_output_stream::operator=(segmented_output_stream&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release_segments();
+
+            m_allocator = other.m_allocator;
+            m_segment_size = other.m_segment_size;
+            m_segments = std::move(other.m_segments);
+            m_length = std::exchange(other.m_length, 0);
+            m_position = std::exchange(other.m_position, 0);
+
+            other.m_segments.clear();
+        }
+        return *this;
+    }
+
+    ///
+    /// @brief      Get the size of every segment.
+    /// @return     Segment size (in bytes).
+    ///
+    std::size_t
+    segmented_output_stream::segment_size() const noexcept
+    {
+        return m_segment_size;
+    }
+
+    ///
+    /// @brief      Get the number of allocated segments.
+    /// @return     Number of segments, including ones which only hold data past the end.
+    ///
+    std::size_t
+    segmented_output_stream::segment_count() const noexcept
+    {
+        return m_segments.size();
+    }
+
+    ///
+    /// @brief      Get views of all written bytes, in order.
+    ///
+    /// Every view but the last one spans a whole segment. Views are invalidated
+    /// by @c clear, and by moving or destroying the stream.
+    ///
+    /// @return     List of views, empty if nothing was written.
+    ///
+    std::vector<weak_buffer>
+    segmented_output_stream::segments() const
+    {
+        std::vector<weak_buffer> views;
+        views.reserve(m_segments.size());
+
+        auto remaining = static_cast<std::size_t>(m_length);
+        for (const auto segment : m_segments)
+        {
+            if (remaining == 0u)
+            {
+                break;
+            }
+
+            const auto size = std::min(remaining, m_segment_size);
+            views.emplace_back(segment, size);
+            remaining -= size;
+        }
+
+        return views;
+    }
+
+    ///
+    /// @brief      Copy all written bytes into a single contiguous buffer.
+    /// @param      alloc           Allocator which should be used by the resulting buffer.
+    /// @throw      io_exception    If @c alloc is NULL, or allocation fails.
+    /// @return     Buffer with a copy of the stream contents.
+    ///
+    owning_buffer
+    segmented_output_stream::flatten(base_allocator* alloc) const
+    {
+        owning_buffer result{ static_cast<std::size_t>(m_length), alloc };
+        result.resize_to_capacity();
+
+        auto dest = result.data();
+        for (const auto& view : segments())
+        {
+            std::memcpy(dest, view.data(), view.length());
+            dest += view.length();
+        }
+
+        return result;
+    }
+
+    ///
+    /// @brief      Drop all contents and free every segment.
+    ///
+    void
+    segmented_output_stream::clear() noexcept
+    {
+        release_segments();
+        m_length = 0;
+        m_position = 0;
+    }
+
+    int64_t
+    segmented_output_stream::position()
+    {
+        return m_position;
+    }
+
+    int64_t
+    segmented_output_stream::length()
+    {
+        return m_length;
+    }
+
+    void
+    segmented_output_stream::seek_begin(int64_t offset)
+    {
+        m_position = DoCalcPosition<seek_origin::begin>(m_length, m_position, offset);
+    }
+
+    void
+    segmented_output_stream::seek_current(int64_t offset)
+    {
+        m_position = DoCalcPosition<seek_origin::current>(m_length, m_position, offset);
+    }
+
+    void
+    segmented_output_stream::seek_end(int64_t offset)
+    {
+        m_position = DoCalcPosition<seek_origin::end>(m_length, m_position, offset);
+    }
+
+    int64_t
+    segmented_output_stream::write_bytes(weak_buffer input)
+    {
+        REIO_ASSERT(input.data() != nullptr, "can't write to output streams from nullptr");
+        REIO_ASSERT(input.length() > 0, "can't write zero bytes to output streams");
+
+        auto source = input.data();
+        auto remaining = input.length();
+        auto position = static_cast<std::size_t>(m_position);
+
+        while (remaining > 0u)
+        {
+            const auto index = position / m_segment_size;
+            const auto offset = position % m_segment_size;
+
+            if (index == m_segments.size())
+            {
+                const auto segment = m_allocator->allocate(m_segment_size);
+                REIO_ASSERT(segment != nullptr, "segmented stream failed to allocate a segment");
+
+                try
+                {
+                    m_segments.push_back(segment);
+                }
+                catch (...)
+                {
+                    m_allocator->deallocate(segment, m_segment_size);
+                    throw;
+                }
+            }
+
+            const auto size = std::min(remaining, m_segment_size - offset);
+            std::memcpy(m_segments[index] + offset, source, size);
+
+            source += size;
+            remaining -= size;
+            position += size;
+        }
+
+        m_position = static_cast<int64_t>(position);
+        m_length = std::max(m_length, m_position);
+
+        return static_cast<int64_t>(input.length());
+    }
+
+    void
+    segmented_output_stream::release_segments() noexcept
+    {
+        for (const auto segment : m_segments)
+        {
+            m_allocator->deallocate(segment, m_segment_size);
+        }
+        m_segments.clear();
+    }
+
+}
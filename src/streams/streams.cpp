@@ -27,6 +27,60 @@ namespace reio
         REIO_ASSERT(read == expected, "failed to read required number of bytes");
     }
 
+    int64_t
+    input_stream::read_bytes_scatter(std::span<const weak_buffer> outputs)
+    {
+        int64_t total = 0;
+        for (const auto& output : outputs)
+        {
+            if (output.length() == 0u)
+            {
+                continue;
+            }
+
+            const auto read = read_bytes(output);
+            total += std::max<int64_t>(read, 0);
+
+            if (read != static_cast<int64_t>(output.length()))
+            {
+                break;
+            }
+        }
+        return total;
+    }
+
+    std::optional<weak_buffer>
+    input_stream::try_read_view([[maybe_unused]] std::size_t size)
+    {
+        return std::nullopt;
+    }
+
+    weak_buffer
+    input_stream::read_view(std::size_t size, owning_buffer& scratch)
+    {
+        if (const auto view = try_read_view(size))
+        {
+            return *view;
+        }
+
+        if (size == 0u)
+        {
+            return {};
+        }
+
+        if (scratch.capacity() < size)
+        {
+            const auto growth = scratch.growth();
+            scratch = owning_buffer{ size, scratch.allocator() };
+            scratch.set_growth(growth);
+        }
+
+        scratch.resize_to_capacity();
+        const auto read = std::max<int64_t>(read_bytes(scratch.first(size)), 0);
+
+        return scratch.first(static_cast<std::size_t>(read));
+    }
+
     bool
     output_stream::write_byte(byte value)
     {
@@ -45,4 +99,26 @@ namespace reio
         [[maybe_unused]] const auto expected = static_cast<int64_t>(input.length());
         REIO_ASSERT(written == expected, "failed to write required number of bytes");
     }
+
+    int64_t
+    output_stream::write_bytes_gather(std::span<const weak_buffer> inputs)
+    {
+        int64_t total = 0;
+        for (const auto& input : inputs)
+        {
+            if (input.length() == 0u)
+            {
+                continue;
+            }
+
+            const auto written = write_bytes(input);
+            total += std::max<int64_t>(written, 0);
+
+            if (written != static_cast<int64_t>(input.length()))
+            {
+                break;
+            }
+        }
+        return total;
+    }
 }
@@ -0,0 +1,89 @@
+#ifndef REIO_VECTORED_HELPERS_HPP
+#define REIO_VECTORED_HELPERS_HPP
+
+#include "reio/asserts.hpp"
+#include "reio/types.hpp"
+#include "reio/buffers/weak_buffer.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <span>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifndef REIO_PLATFORM_POSIX
+    #error Vectored I/O helpers are only implemented for POSIX platforms
+#endif
+
+
+namespace reio
+{
+
+    ///
+    /// @brief      Transfer a sequence of buffers at a file offset with as few syscalls as possible.
+    ///
+    /// Uses positional I/O, so the file offset of the descriptor is left as is,
+    /// and callers keep track of their own position. Shared by all streams
+    /// which are backed by a file descriptor. Interrupted calls are retried,
+    /// short ones are continued, and the transfer stops at EOF or on error.
+    ///
+    template<bool Write>
+    inline int64_t DoTransferVectored(int fd, int64_t offset, std::span<const weak_buffer> buffers)
+    {
+        constexpr std::size_t max_batch = IOV_MAX < 64 ? IOV_MAX : 64;
+
+        int64_t total = 0;
+        std::size_t index = 0u;
+        std::size_t consumed = 0u;    // bytes already transferred from buffers[index]
+
+        while (index < buffers.size())
+        {
+            ::iovec batch[max_batch];
+            std::size_t count = 0u;
+
+            for (auto i = index; i < buffers.size() && count < max_batch; i++)
+            {
+                const auto skip = i == index ? consumed : 0u;
+                if (buffers[i].length() > skip)
+                {
+                    batch[count++] = { buffers[i].data() + skip, buffers[i].length() - skip };
+                }
+            }
+
+            if (count == 0u)
+            {
+                break;
+            }
+
+            const auto done = Write
+                ? ::pwritev(fd, batch, static_cast<int>(count), static_cast<off_t>(offset + total))
+                : ::preadv(fd, batch, static_cast<int>(count), static_cast<off_t>(offset + total));
+
+            if (done < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (done <= 0)
+            {
+                break;
+            }
+
+            total += done;
+
+            // advance over fully transferred buffers, possibly stopping in the middle of one
+            auto remaining = static_cast<std::size_t>(done);
+            while (index < buffers.size() && remaining >= buffers[index].length() - consumed)
+            {
+                remaining -= buffers[index].length() - consumed;
+                consumed = 0u;
+                index++;
+            }
+            consumed += remaining;
+        }
+
+        return total;
+    }
+
+}
+
+#endif //REIO_VECTORED_HELPERS_HPP
@@ -0,0 +1,363 @@
+#include "reio/streams/write_behind_streams.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+
+namespace reio
+{
+
+    write_behind_output_stream::write_behind_output_stream(output_stream* sink,
+                                                           std::size_t slot_size,
+                                                           std::size_t slot_count,
+                                                           base_allocator* alloc)
+        : m_sink{ sink }
+        , m_storage{ alloc }
+        , m_slot_size{ slot_size }
+        , m_slot_count{ slot_count }
+        , m_slot{ 0u }
+        , m_window_start{ 0 }
+        , m_window_length{ 0u }
+        , m_cursor{ 0u }
+        , m_queue(slot_count)
+        , m_queue_head{ 0u }
+        , m_queue_count{ 0u }
+        , m_writing{ false }
+        , m_stopping{ false }
+        , m_failed{ false }
+    {
+        REIO_ASSERT(sink != nullptr, "can't initialize write-behind output stream with a null sink");
+        REIO_ASSERT(slot_size != 0u, "can't initialize write-behind output stream with empty slots");
+        REIO_ASSERT(slot_count >= 2u, "write-behind output stream needs at least two slots");
+
+        m_storage = owning_buffer{ slot_size * slot_count, alloc };
+        m_window_start = sink->position();
+
+        // the first slot is handed to the producer right away
+        m_free.reserve(slot_count);
+        for (std::size_t i = slot_count - 1u; i > 0u; i--)
+        {
+            m_free.push_back(i);
+        }
+
+        m_worker = std::thread{ &write_behind_output_stream::worker_main, this };
+    }
+
+    write_behind_output_stream::~write_behind_output_stream()
+    {
+        [[maybe_unused]] bool ok = true;
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+            ok = false;
+        }
+
+        {
+            std::lock_guard lock{ m_mutex };
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_worker.join();
+
+#ifdef _DEBUG
+        if (!ok)
+        {
+            std::fputs("warning: failed to flush pending bytes in ~write_behind_output_stream", stderr);
+        }
+#endif
+    }
+
+    ///
+    /// @brief      Get the wrapped stream.
+    /// @return     Pointer to the stream which is used as a data sink.
+    ///
+    output_stream*
+    write_behind_output_stream::sink() const noexcept
+    {
+        return m_sink;
+    }
+
+    ///
+    /// @brief      Get the maximum number of bytes which are written by the worker at once.
+    /// @return     Capacity (in bytes) of every slot.
+    ///
+    std::size_t
+    write_behind_output_stream::slot_size() const noexcept
+    {
+        return m_slot_size;
+    }
+
+    ///
+    /// @brief      Get the number of slots.
+    /// @return     Maximum number of blocks which are pending at once.
+    ///
+    std::size_t
+    write_behind_output_stream::slot_count() const noexcept
+    {
+        return m_slot_count;
+    }
+
+    ///
+    /// @brief      Write all pending bytes into the wrapped stream, and wait until it's done.
+    ///
+    /// Afterwards, the wrapped stream is positioned at this stream's
+    /// current position, even if the cursor was moved back within the slot.
+    ///
+    /// @throw      ...     Failure of the wrapped stream, or io_exception if it didn't accept all bytes.
+    ///
+    void
+    write_behind_output_stream::flush()
+    {
+        const auto rewind = static_cast<int64_t>(m_cursor) - static_cast<int64_t>(m_window_length);
+        const auto target = m_window_start + static_cast<int64_t>(m_cursor);
+
+        if (m_window_length > 0u)
+        {
+            submit();
+        }
+        drain();
+
+        m_window_start = target;
+        check_failure();
+
+        if (rewind != 0)
+        {
+            m_sink->seek_current(rewind);
+        }
+    }
+
+    int64_t
+    write_behind_output_stream::position()
+    {
+        return m_window_start + static_cast<int64_t>(m_cursor);
+    }
+
+    int64_t
+    write_behind_output_stream::length()
+    {
+        drain();
+        check_failure();
+
+        // the pending slot might either overwrite existing bytes, or extend the sink
+        const auto window_end = m_window_start + static_cast<int64_t>(m_window_length);
+        return std::max(m_sink->length(), window_end);
+    }
+
+    void
+    write_behind_output_stream::seek_begin(int64_t offset)
+    {
+        check_failure();
+        if (try_seek_within(offset))
+        {
+            return;
+        }
+
+        flush();
+        m_sink->seek_begin(offset);
+        m_window_start = offset;
+    }
+
+    void
+    write_behind_output_stream::seek_current(int64_t offset)
+    {
+        check_failure();
+        if (try_seek_within(position() + offset))
+        {
+            return;
+        }
+
+        flush();
+        m_sink->seek_current(offset);
+        m_window_start += offset;
+    }
+
+    void
+    write_behind_output_stream::seek_end(int64_t offset)
+    {
+        check_failure();
+        flush();
+        m_sink->seek_end(offset);
+        m_window_start = m_sink->position();
+    }
+
+    ///
+    /// @brief      Put bytes into the current slot, queueing it for the worker as it fills up.
+    ///
+    /// @param      input           View of memory to write; implicitly defines the written number of bytes.
+    /// @throw      ...             Failure of a previously queued write.
+    ///
+    /// @return     Number of bytes accepted by this stream.
+    ///
+    int64_t
+    write_behind_output_stream::write_bytes(weak_buffer input)
+    {
+        REIO_ASSERT(input.data() != nullptr, "can't write to output streams from nullptr");
+        REIO_ASSERT(input.length() > 0, "can't write zero bytes to output streams");
+
+        check_failure();
+
+        auto src = input.data();
+        auto remaining = input.length();
+
+        while (remaining > 0u)
+        {
+            const auto space = m_slot_size - m_cursor;
+            if (space == 0u)
+            {
+                submit();
+                continue;
+            }
+
+            const auto accepted = std::min(space, remaining);
+            std::copy_n(src, accepted, slot_data(m_slot) + m_cursor);
+
+            m_cursor += accepted;
+            m_window_length = std::max(m_window_length, m_cursor);
+            src += accepted;
+            remaining -= accepted;
+        }
+
+        return static_cast<int64_t>(input.length());
+    }
+
+    bool
+    write_behind_output_stream::write_byte(byte value)
+    {
+        check_failure();
+
+        if (m_cursor == m_slot_size)
+        {
+            submit();
+        }
+
+        slot_data(m_slot)[m_cursor++] = value;
+        m_window_length = std::max(m_window_length, m_cursor);
+
+        return true;
+    }
+
+    byte*
+    write_behind_output_stream::slot_data(std::size_t index) const noexcept
+    {
+        return m_storage.data() + index * m_slot_size;
+    }
+
+    bool
+    write_behind_output_stream::try_seek_within(int64_t target) noexcept
+    {
+        // unlike input, the end of the pending block is a valid position too
+        const auto window_end = m_window_start + static_cast<int64_t>(m_window_length);
+        if (target < m_window_start || target > window_end)
+        {
+            return false;
+        }
+
+        m_cursor = static_cast<std::size_t>(target - m_window_start);
+        return true;
+    }
+
+    ///
+    /// @brief      Rethrow a failure of the worker, if there's one which wasn't reported yet.
+    ///
+    void
+    write_behind_output_stream::check_failure()
+    {
+        if (!m_failed.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        std::lock_guard lock{ m_mutex };
+        m_failed.store(false, std::memory_order_relaxed);
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+
+    ///
+    /// @brief      Queue pending bytes for the worker, and continue with a free slot right after them.
+    ///
+    /// Blocks while all slots are queued.
+    ///
+    void
+    write_behind_output_stream::submit()
+    {
+        std::unique_lock lock{ m_mutex };
+
+        m_queue[(m_queue_head + m_queue_count) % m_slot_count] = { m_slot, m_window_length };
+        m_queue_count++;
+        m_wake.notify_one();
+
+        m_changed.wait(lock, [this]() { return !m_free.empty(); });
+        m_slot = m_free.back();
+        m_free.pop_back();
+
+        m_window_start += static_cast<int64_t>(m_window_length);
+        m_window_length = 0u;
+        m_cursor = 0u;
+    }
+
+    ///
+    /// @brief      Wait until all queued slots are written, so that the wrapped stream can be used directly.
+    ///
+    void
+    write_behind_output_stream::drain()
+    {
+        std::unique_lock lock{ m_mutex };
+        m_changed.wait(lock, [this]() { return m_queue_count == 0u && !m_writing; });
+    }
+
+    void
+    write_behind_output_stream::worker_main()
+    {
+        std::unique_lock lock{ m_mutex };
+
+        while (true)
+        {
+            m_wake.wait(lock, [this]() { return m_stopping || m_queue_count > 0u; });
+
+            if (m_queue_count == 0u)
+            {
+                return;
+            }
+
+            const auto slot = m_queue[m_queue_head];
+            m_queue_head = (m_queue_head + 1u) % m_slot_count;
+            m_queue_count--;
+
+            // slots queued before the producer noticed a failure are dropped
+            const auto skip = static_cast<bool>(m_error);
+            m_writing = true;
+            lock.unlock();
+
+            std::exception_ptr error;
+            if (!skip)
+            {
+                try
+                {
+                    [[maybe_unused]] const auto written = m_sink->write_bytes(weak_buffer{ slot_data(slot.m_index), slot.m_length });
+                    REIO_ASSERT(written == static_cast<int64_t>(slot.m_length), "failed to write a slot into the wrapped stream");
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+            }
+
+            lock.lock();
+            m_writing = false;
+            m_free.push_back(slot.m_index);
+
+            if (error)
+            {
+                m_error = error;
+                m_failed.store(true, std::memory_order_release);
+            }
+
+            m_changed.notify_all();
+        }
+    }
+
+}
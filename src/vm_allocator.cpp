@@ -0,0 +1,209 @@
+#include "reio/vm_allocator.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+namespace reio
+{
+
+    ///
+    /// @brief      Initialize the allocator.
+    /// @param      options         Mapping threshold and flags.
+    /// @param      fallback        Allocator for blocks below the threshold.
+    /// @throw      io_exception    If the threshold is zero, or @c fallback is NULL.
+    ///
+    vm_allocator::vm_allocator(vm_options options, base_allocator* fallback)
+        : m_options{ options }, m_fallback{ fallback }
+        , m_page_size{ static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) }
+    {
+        REIO_ASSERT(options.m_threshold > 0u, "vm allocator threshold must be positive");
+        REIO_ASSERT(fallback != nullptr, "vm allocator can't have null fallback allocator");
+    }
+
+    ///
+    /// @brief      Map a new block, or pass small requests to the fallback allocator.
+    /// @param      size        Number of bytes to allocate.
+    /// @param      alignment   Alignment of the block; mappings are page-aligned.
+    /// @return     Pointer to the block, or NULL if mapping failed.
+    ///
+    byte*
+    vm_allocator::allocate(std::size_t size, std::size_t alignment)
+    {
+        return is_mapped(size, alignment) ? map(size) : m_fallback->allocate(size, alignment);
+    }
+
+    ///
+    /// @brief      Unmap a block, or pass small blocks to the fallback allocator.
+    /// @param      ptr         Pointer returned by @c allocate.
+    /// @param      size        Size which was passed to @c allocate.
+    /// @param      alignment   Alignment which was passed to @c allocate.
+    ///
+    void
+    vm_allocator::deallocate(byte* ptr, std::size_t size, std::size_t alignment)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        if (is_mapped(size, alignment))
+        {
+            ::munmap(ptr, page_round(size));
+        }
+        else
+        {
+            m_fallback->deallocate(ptr, size, alignment);
+        }
+    }
+
+    ///
+    /// @brief      Resize a mapped block without moving it.
+    ///
+    /// Succeeds if the block keeps its page count, shrinks, or (on Linux)
+    /// if the pages right after it are free.
+    ///
+    /// @param      ptr         Pointer returned by @c allocate.
+    /// @param      old_size    Current size of the block.
+    /// @param      new_size    Requested size of the block.
+    /// @param      alignment   Alignment which was passed to @c allocate.
+    /// @return     Whether the block now has @c new_size bytes, at the same address.
+    ///
+    bool
+    vm_allocator::try_expand(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment)
+    {
+        if (!is_mapped(old_size, alignment) || !is_mapped(new_size, alignment))
+        {
+            return !is_mapped(old_size, alignment) && !is_mapped(new_size, alignment)
+                && m_fallback->try_expand(ptr, old_size, new_size, alignment);
+        }
+
+        const auto old_pages = page_round(old_size);
+        const auto new_pages = page_round(new_size);
+
+        if (new_pages == old_pages)
+        {
+            return true;
+        }
+
+        if (new_pages < old_pages)
+        {
+            return ::munmap(ptr + new_pages, old_pages - new_pages) == 0;
+        }
+
+#ifdef __linux__
+        return ::mremap(ptr, old_pages, new_pages, 0) != MAP_FAILED;
+#else
+        return false;
+#endif
+    }
+
+    ///
+    /// @brief      Resize a block, remapping pages of big blocks instead of copying them.
+    /// @param      ptr         Pointer returned by @c allocate.
+    /// @param      old_size    Current size of the block.
+    /// @param      new_size    Requested size of the block.
+    /// @param      preserved   Number of leading bytes which must be kept.
+    /// @param      alignment   Alignment which was passed to @c allocate, and which the block keeps.
+    /// @return     Pointer to the resized block, or NULL if the allocation failed.
+    ///
+    byte*
+    vm_allocator::reallocate(byte* ptr, std::size_t old_size, std::size_t new_size, std::size_t preserved,
+                             std::size_t alignment)
+    {
+        if (!is_mapped(old_size, alignment) && !is_mapped(new_size, alignment))
+        {
+            return m_fallback->reallocate(ptr, old_size, new_size, preserved, alignment);
+        }
+
+        if (is_mapped(old_size, alignment) && is_mapped(new_size, alignment))
+        {
+            if (try_expand(ptr, old_size, new_size, alignment))
+            {
+                return ptr;
+            }
+
+#ifdef __linux__
+            const auto remapped = ::mremap(ptr, page_round(old_size), page_round(new_size), MREMAP_MAYMOVE);
+            if (remapped == MAP_FAILED)
+            {
+                return nullptr;
+            }
+
+            // the mapping keeps its flags, including the huge page advice
+            return static_cast<byte*>(remapped);
+#endif
+        }
+
+        // crossing the threshold (or no mremap), so the preserved part has to be copied
+        const auto allocation = allocate(new_size, alignment);
+        if (allocation != nullptr)
+        {
+            std::memcpy(allocation, ptr, std::min({ preserved, old_size, new_size }));
+            deallocate(ptr, old_size, alignment);
+        }
+        return allocation;
+    }
+
+    ///
+    /// @brief      Get the allocator options.
+    /// @return     Options passed on initialization.
+    ///
+    const vm_options&
+    vm_allocator::options() const noexcept
+    {
+        return m_options;
+    }
+
+    ///
+    /// @brief      Get the granularity of mapped blocks.
+    /// @return     System page size (in bytes).
+    ///
+    std::size_t
+    vm_allocator::page_size() const noexcept
+    {
+        return m_page_size;
+    }
+
+    ///
+    /// @brief      Check whether a block of a certain size would get its own mapping.
+    /// @param      size        Number of bytes to allocate.
+    /// @param      alignment   Alignment of the block.
+    /// @return     Whether @c size reaches the mapping threshold, and pages are aligned enough.
+    ///
+    bool
+    vm_allocator::is_mapped(std::size_t size, std::size_t alignment) const noexcept
+    {
+        return size >= m_options.m_threshold && alignment <= m_page_size;
+    }
+
+    std::size_t
+    vm_allocator::page_round(std::size_t size) const noexcept
+    {
+        return (size + m_page_size - 1u) / m_page_size * m_page_size;
+    }
+
+    byte*
+    vm_allocator::map(std::size_t size) const noexcept
+    {
+        const auto mapping = ::mmap(nullptr, page_round(size), PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+#ifdef MADV_HUGEPAGE
+        if (m_options.m_huge_pages)
+        {
+            // only a hint, so failures (e.g. THP being disabled) are ignored
+            ::madvise(mapping, page_round(size), MADV_HUGEPAGE);
+        }
+#endif
+
+        return static_cast<byte*>(mapping);
+    }
+
+}
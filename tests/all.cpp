@@ -1,6 +1,26 @@
 #include "Catch2/catch.hpp"
 
+#include "reio/test_allocators.cpp"
+#include "reio/test_byteswap.cpp"
 #include "reio/test_types.cpp"
 #include "reio/buffers/test_owning_buffer.cpp"
+#include "reio/buffers/test_small_buffer.cpp"
 #include "reio/buffers/test_weak_buffer.cpp"
+#include "reio/streams/test_buffered_streams.cpp"
+#include "reio/streams/test_file_streams.cpp"
 #include "reio/streams/test_memory_streams.cpp"
+#include "reio/streams/test_parallel_reader.cpp"
+#include "reio/streams/test_prefetching_streams.cpp"
+#include "reio/streams/test_random_access.cpp"
+#include "reio/streams/test_readers.cpp"
+#include "reio/streams/test_segmented_streams.cpp"
+#include "reio/streams/test_write_behind_streams.cpp"
+
+#ifdef REIO_PLATFORM_POSIX
+#include "reio/test_io_engine.cpp"
+#include "reio/test_vm_allocator.cpp"
+#include "reio/streams/test_async_streams.cpp"
+#include "reio/streams/test_engine_streams.cpp"
+#include "reio/streams/test_fd_streams.cpp"
+#include "reio/streams/test_mmap_streams.cpp"
+#endif
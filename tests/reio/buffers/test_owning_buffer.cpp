@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <array>
+#include <cstdint>
 
+#include "reio/allocators.hpp"
 #include "reio/buffers/owning_buffer.hpp"
 #include "reio/buffers/weak_buffer.hpp"
 using namespace reio;
@@ -381,7 +383,6 @@ TEST_CASE( "owning buffer can be overwritten", "[buffer][owning_buffer]" ) {
         auto end_3 = buffer.overwrite(repl.begin(), repl.end(), buffer.begin());
         auto result_3 = std::array{ 21u, 22u, 23u, 24u, 25u, 26u, 27u, 28u, 29u, 30u, 31u, 32u };
 
-        CHECK( buffer.data() != old_data );
         CHECK( buffer.length() == repl.size() );
         CHECK( buffer.capacity() >= old_capacity );
         CHECK( buffer.capacity() >= repl.size() );
@@ -430,7 +431,6 @@ TEST_CASE( "owning buffer can be overwritten", "[buffer][owning_buffer]" ) {
         auto end_3 = buffer.overwrite(repl.begin(), repl.begin() + 7u, buffer.begin() + 4u);
         auto result_3 = std::array{ 1u, 2u, 3u, 4u, 21u, 22u, 23u, 24u, 25u, 26u, 27u };
 
-        CHECK( buffer.data() != old_data );
         CHECK( buffer.length() == 11u );
         CHECK( buffer.capacity() >= old_capacity );
         CHECK( buffer.capacity() >= repl.size() );
@@ -457,7 +457,6 @@ TEST_CASE( "owning buffer can be overwritten", "[buffer][owning_buffer]" ) {
         auto end_1 = buffer.overwrite(repl.begin(), repl.begin() + 1u, buffer.end());
         auto result_1 = std::array{ 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u, 21u };
 
-        CHECK( buffer.data() != old_data );
         CHECK( buffer.capacity() >= old_capacity );
         CHECK( buffer.length() == 11u );
         CHECK( std::ranges::equal(buffer, result_1) );
@@ -686,3 +685,42 @@ TEST_CASE( "owning buffer can be removed from", "[buffer][owning_buffer]" ) {
     }
 
 }
+
+
+TEST_CASE( "owning buffer keeps its alignment", "[buffer][owning_buffer]" ) {
+
+    std::array<uint8_t, 4u> junk = { 0x01, 0x02, 0x03, 0x04 };
+
+    SECTION( "when growing" ) {
+        owning_buffer buffer{ 3u, std::align_val_t{ 64u } };
+        CHECK( buffer.alignment() == 64u );
+        CHECK( reinterpret_cast<std::uintptr_t>(buffer.data()) % 64u == 0u );
+
+        for (int i = 0; i < 1000; i++)
+        {
+            buffer.insert(junk.begin(), junk.end(), buffer.end());
+            REQUIRE( reinterpret_cast<std::uintptr_t>(buffer.data()) % 64u == 0u );
+        }
+
+        CHECK( buffer.length() == 4000u );
+        CHECK( buffer[3999] == 0x04 );
+    }
+
+    SECTION( "when allocated lazily, and through custom allocators" ) {
+        arena_allocator arena{ 256u };
+        owning_buffer buffer{ 0u, std::align_val_t{ 4096u }, &arena };
+
+        CHECK( buffer.data() == nullptr );
+        buffer.insert(junk.begin(), junk.end(), buffer.end());
+        CHECK( reinterpret_cast<std::uintptr_t>(buffer.data()) % 4096u == 0u );
+
+        owning_buffer moved{ std::move(buffer) };
+        CHECK( moved.alignment() == 4096u );
+        CHECK( buffer.alignment() == k_default_alignment );
+    }
+
+    SECTION( "but not with alignments which aren't powers of two" ) {
+        CHECK( owning_buffer{ 10u, std::align_val_t{ 1u } }.alignment() == k_default_alignment );
+        CHECK_THROWS_AS( (owning_buffer{ 10u, std::align_val_t{ 24u } }), io_exception );
+    }
+}
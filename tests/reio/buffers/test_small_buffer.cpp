@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <array>
+
+#include "reio/buffers/small_buffer.hpp"
+#include "reio/buffers/weak_buffer.hpp"
+using namespace reio;
+
+
+///
+/// Allocator which counts calls, to check when small buffers leave their inline storage.
+///
+class small_buffer_counting_allocator final
+    : public base_allocator
+{
+public:
+
+    std::size_t m_allocations = 0u;
+    std::size_t m_live_count = 0u;
+
+    byte* allocate(std::size_t size, std::size_t alignment = k_default_alignment) override
+    {
+        m_allocations++;
+        m_live_count++;
+        return default_allocator::get_default()->allocate(size, alignment);
+    }
+
+    void deallocate(byte* ptr, std::size_t size, std::size_t alignment = k_default_alignment) override
+    {
+        m_live_count--;
+        default_allocator::get_default()->deallocate(ptr, size, alignment);
+    }
+};
+
+
+TEST_CASE( "small buffer can be initialized", "[buffer][small_buffer]" ) {
+
+    std::array<byte, 20u> junk{};
+    for (std::size_t i = 0u; i < junk.size(); i++)
+    {
+        junk[i] = static_cast<byte>(i + 1u);
+    }
+
+    small_buffer_counting_allocator alloc{};
+
+    SECTION( "it is empty and inline after default initialization" ) {
+        small_buffer<16u> buffer{ &alloc };
+        CHECK( buffer.length() == 0 );
+        CHECK( buffer.capacity() == 16u );
+        CHECK( buffer.is_inline() );
+        CHECK( buffer.data() != nullptr );
+        CHECK( buffer.growth() == k_default_growth_factor );
+        CHECK( buffer.allocator() == &alloc );
+        CHECK( small_buffer<16u>::inline_capacity() == 16u );
+    }
+
+    SECTION( "it only allocates when preallocating beyond the inline storage" ) {
+        small_buffer<16u> small{ 10u, &alloc };
+        CHECK( small.is_inline() );
+        CHECK( small.capacity() == 16u );
+
+        small_buffer<16u> big{ 100u, &alloc };
+        CHECK( !big.is_inline() );
+        CHECK( big.capacity() == 100u );
+        CHECK( big.length() == 0u );
+        CHECK( alloc.m_allocations == 1u );
+    }
+
+    SECTION( "it has the correct contents after fill initialization" ) {
+        small_buffer<16u> buffer{ 8u, 2u, &alloc };
+        CHECK( buffer.length() == 8u );
+        CHECK( std::ranges::all_of(buffer, [](byte b) { return b == 2u; }) );
+        CHECK( alloc.m_allocations == 0u );
+    }
+
+    SECTION( "it has the correct contents after memcopy initialization" ) {
+        small_buffer<16u> small{ weak_buffer{ junk.data(), 16u }, &alloc };
+        CHECK( small.is_inline() );
+        CHECK( small.length() == 16u );
+        CHECK( std::equal(small.begin(), small.end(), junk.begin()) );
+
+        small_buffer<16u> big{ weak_buffer{ junk.data(), junk.size() }, &alloc };
+        CHECK( !big.is_inline() );
+        CHECK( big.length() == junk.size() );
+        CHECK( std::equal(big.begin(), big.end(), junk.begin()) );
+        CHECK( alloc.m_allocations == 1u );
+    }
+
+    CHECK( alloc.m_live_count == 0u );
+}
+
+
+TEST_CASE( "small buffer supports move semantics", "[buffer][small_buffer]" ) {
+
+    std::array<byte, 20u> junk{};
+    for (std::size_t i = 0u; i < junk.size(); i++)
+    {
+        junk[i] = static_cast<byte>(i + 1u);
+    }
+
+    small_buffer_counting_allocator alloc{};
+
+    SECTION( "inline contents are copied" ) {
+        small_buffer<8u> origin{ weak_buffer{ junk.data(), 4u }, &alloc };
+        small_buffer<8u> target{ std::move(origin) };
+
+        CHECK( target.is_inline() );
+        CHECK( target.length() == 4u );
+        CHECK( target[3] == 4u );
+        CHECK( target.allocator() == &alloc );
+
+        CHECK( origin.is_inline() );
+        CHECK( origin.length() == 0u );
+    }
+
+    SECTION( "heap contents are taken over" ) {
+        small_buffer<8u> origin{ weak_buffer{ junk.data(), junk.size() }, &alloc };
+        const auto heap = origin.data();
+
+        small_buffer<8u> target{ &alloc };
+        target = std::move(origin);
+
+        CHECK( target.data() == heap );
+        CHECK( target.length() == junk.size() );
+        CHECK( origin.is_inline() );
+        CHECK( origin.capacity() == 8u );
+        CHECK( alloc.m_allocations == 1u );
+        CHECK( alloc.m_live_count == 1u );
+
+        // moved-from buffers stay usable
+        origin.insert(junk.begin(), junk.begin() + 2, origin.end());
+        CHECK( origin.length() == 2u );
+    }
+
+    SECTION( "assignment frees the previous heap contents" ) {
+        small_buffer<8u> target{ 100u, &alloc };
+        small_buffer<8u> origin{ weak_buffer{ junk.data(), 3u }, &alloc };
+
+        target = std::move(origin);
+
+        CHECK( target.is_inline() );
+        CHECK( target.length() == 3u );
+        CHECK( alloc.m_live_count == 0u );
+    }
+
+    CHECK( alloc.m_live_count == 0u );
+}
+
+
+TEST_CASE( "small buffer provides partial access", "[buffer][small_buffer]" ) {
+
+    std::array<byte, 6u> junk = { 1u, 2u, 3u, 4u, 5u, 6u };
+    small_buffer<16u> buffer{ weak_buffer{ junk.data(), junk.size() } };
+
+    CHECK( buffer.at(5) == 6u );
+    CHECK_THROWS_AS( buffer.at(6), io_exception );
+
+    CHECK( buffer.view().length() == 6u );
+    CHECK( buffer.subview(1u, 2u).data()[0] == 2u );
+    CHECK( buffer.first(2u).length() == 2u );
+    CHECK( buffer.last(2u).data()[0] == 5u );
+    CHECK( buffer.last_from(4u).length() == 2u );
+
+    CHECK_THROWS_AS( buffer.subview(5u, 2u), io_exception );
+    CHECK_THROWS_AS( buffer.first(7u), io_exception );
+    CHECK_THROWS_AS( buffer.last(7u), io_exception );
+    CHECK_THROWS_AS( buffer.last_from(7u), io_exception );
+}
+
+
+TEST_CASE( "small buffer can be modified", "[buffer][small_buffer]" ) {
+
+    std::array<byte, 4u> junk = { 0xAAu, 0xBBu, 0xCCu, 0xDDu };
+    small_buffer_counting_allocator alloc{};
+
+    SECTION( "by overwriting, within and past the inline storage" ) {
+        small_buffer<8u> buffer{ &alloc };
+
+        buffer.overwrite(junk.begin(), junk.end(), buffer.begin());
+        buffer.overwrite(junk.begin(), junk.end(), buffer.begin() + 2);
+        CHECK( buffer.length() == 6u );
+        CHECK( buffer.is_inline() );
+        CHECK( buffer[1] == 0xBBu );
+        CHECK( buffer[2] == 0xAAu );
+
+        buffer.overwrite(junk.begin(), junk.end(), buffer.end());
+        CHECK( buffer.length() == 10u );
+        CHECK( !buffer.is_inline() );
+        CHECK( buffer.capacity() == 16u );
+        CHECK( buffer[5] == 0xDDu );
+        CHECK( buffer[9] == 0xDDu );
+        CHECK( alloc.m_allocations == 1u );
+
+        CHECK_THROWS_AS( buffer.overwrite(junk.begin(), junk.end(), buffer.end() + 1), io_exception );
+        CHECK_THROWS_AS( buffer.overwrite(junk.end(), junk.begin(), buffer.begin()), io_exception );
+    }
+
+    SECTION( "by inserting, within and past the inline storage" ) {
+        small_buffer<8u> buffer{ &alloc };
+
+        buffer.insert(junk.begin(), junk.end(), buffer.begin());
+        buffer.insert(junk.begin(), junk.begin() + 2, buffer.begin() + 1);
+        CHECK( buffer.length() == 6u );
+        CHECK( buffer.is_inline() );
+        CHECK( std::ranges::equal(buffer, std::array<byte, 6u>{ 0xAAu, 0xAAu, 0xBBu, 0xBBu, 0xCCu, 0xDDu }) );
+
+        buffer.insert(junk.begin(), junk.end(), buffer.begin());
+        CHECK( !buffer.is_inline() );
+        CHECK( buffer.length() == 10u );
+        CHECK( buffer[0] == 0xAAu );
+        CHECK( buffer[4] == 0xAAu );
+        CHECK( buffer[9] == 0xDDu );
+
+        for (int i = 0; i < 100; i++)
+        {
+            buffer.insert(junk.begin(), junk.end(), buffer.end());
+        }
+        CHECK( buffer.length() == 410u );
+        CHECK( buffer[409] == 0xDDu );
+        CHECK( alloc.m_live_count == 1u );
+    }
+
+    SECTION( "by erasing, without moving back inline" ) {
+        small_buffer<8u> buffer{ weak_buffer{ junk.data(), junk.size() }, &alloc };
+
+        buffer.erase(buffer.begin() + 1, buffer.begin() + 3);
+        CHECK( std::ranges::equal(buffer, std::array<byte, 2u>{ 0xAAu, 0xDDu }) );
+
+        buffer.insert(junk.begin(), junk.end(), buffer.end());
+        buffer.insert(junk.begin(), junk.end(), buffer.end());
+        CHECK( !buffer.is_inline() );
+
+        buffer.erase(buffer.begin(), buffer.end());
+        CHECK( buffer.length() == 0u );
+        CHECK( !buffer.is_inline() );
+
+        CHECK_THROWS_AS( buffer.erase(buffer.begin(), buffer.begin() + 1), io_exception );
+    }
+
+    SECTION( "but not past the inline storage without growth" ) {
+        small_buffer<4u> buffer{ &alloc };
+        buffer.set_growth(growth_factor::none);
+
+        buffer.insert(junk.begin(), junk.end(), buffer.begin());
+        CHECK_THROWS_AS( buffer.insert(junk.begin(), junk.end(), buffer.end()), io_exception );
+        CHECK( buffer.length() == 4u );
+        CHECK( alloc.m_allocations == 0u );
+    }
+
+    CHECK( alloc.m_live_count == 0u );
+}
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "reio/streams/async_streams.hpp"
+#include "reio/streams/fd_streams.hpp"
+#include "reio/streams/memory_streams.hpp"
+using namespace reio;
+
+
+static constexpr auto k_async_stream_small_path = REIO_TESTS_DATA_DIR "/small.bin";
+
+
+static task<int64_t> DoAsyncReadAll(input_stream& stream, weak_buffer output)
+{
+    int64_t total = 0;
+    while (total < static_cast<int64_t>(output.length()))
+    {
+        const auto read = co_await async_read_bytes(stream, output.last_from(total));
+        if (read == 0)
+        {
+            break;
+        }
+        total += read;
+    }
+    co_return total;
+}
+
+static task<uint32_t> DoAsyncReadHeader(input_stream& stream)
+{
+    const auto first = co_await async_read_numeric<uint32_t, std::endian::big>(stream);
+    const auto second = co_await async_read_numeric<uint16_t, std::endian::big>(stream);
+    co_return first + second;
+}
+
+static task<void> DoAsyncSumFile(std::vector<int64_t>& sums, std::size_t index)
+{
+    fd_input_stream stream{ k_async_stream_small_path };
+    std::array<byte, 32u> data{};
+
+    const auto read = co_await DoAsyncReadAll(stream, weak_buffer{ data.data(), data.size() });
+
+    int64_t sum = 0;
+    for (int64_t i = 0; i < read; i++)
+    {
+        sum += data[i];
+    }
+    sums[index] = sum;
+}
+
+static task<void> DoAsyncFail(input_stream& stream)
+{
+    std::array<byte, 4u> data{};
+    co_await async_read_bytes(stream, weak_buffer{ data.data(), data.size() });
+    REIO_FAIL("async task failed on purpose", __FILE__, __LINE__, _REIO_FUNC_);
+}
+
+
+TEST_CASE( "event loop runs tasks reading from streams", "[streams][async_streams][input_streams]" )
+{
+    const auto force_fallback = GENERATE( false, true );
+    event_loop loop{ { .m_queue_depth = 8u, .m_force_fallback = force_fallback } };
+
+    CHECK( event_loop::current() == nullptr );
+    CHECK( (loop.engine().backend() == io_backend::uring) == (io_engine::is_uring_supported() && !force_fallback) );
+
+    SECTION( "of file descriptors through the engine" )
+    {
+        fd_input_stream stream{ k_async_stream_small_path };
+        std::array<byte, 32u> data{};
+
+        CHECK( loop.run(DoAsyncReadAll(stream, weak_buffer{ data.data(), data.size() })) == 19 );
+        CHECK( stream.position() == 19 );
+        CHECK( data[0] == 0x01 );
+        CHECK( data[4] == 0x0C );
+        CHECK( data[18] == 0x01 );
+        CHECK( event_loop::current() == nullptr );
+    }
+
+    SECTION( "of other streams through worker threads" )
+    {
+        std::array<byte, 19u> junk{};
+        for (std::size_t i = 0u; i < junk.size(); i++)
+        {
+            junk[i] = static_cast<byte>(i + 1u);
+        }
+
+        memory_input_stream stream{ weak_buffer{ junk.data(), junk.size() } };
+        std::array<byte, 32u> data{};
+
+        CHECK( loop.run(DoAsyncReadAll(stream, weak_buffer{ data.data(), data.size() })) == 19 );
+        CHECK( stream.position() == 19 );
+        CHECK( data[18] == 19u );
+    }
+
+    SECTION( "of numeric values with endianness conversion" )
+    {
+        fd_input_stream file{ k_async_stream_small_path };
+        CHECK( loop.run(DoAsyncReadHeader(file)) == 0x01020304u + 0x0CA8u );
+        CHECK( file.position() == 6 );
+
+        std::array<byte, 6u> junk{ 0x00, 0x00, 0x00, 0x0C, 0xA8, 0x61 };
+        memory_input_stream memory{ weak_buffer{ junk.data(), junk.size() } };
+        CHECK( loop.run(DoAsyncReadHeader(memory)) == 12u + 43105u );
+    }
+
+    SECTION( "of many files concurrently" )
+    {
+        std::vector<int64_t> sums(300u, 0);
+        for (std::size_t i = 0u; i < sums.size(); i++)
+        {
+            loop.spawn(DoAsyncSumFile(sums, i));
+        }
+
+        loop.run();
+
+        const int64_t expected = 0x01 + 0x02 + 0x03 + 0x04 + 0x0C + 0xA8 + 0x61 + 0x34 + 0x21 + 0x6F
+                               + 0x7E + 0x4E + 0xF3 + 0x30 + 0xA6 + 0x4B + 0x9B + 0xB6 + 0x01;
+        CHECK( std::ranges::all_of(sums, [expected](int64_t sum) { return sum == expected; }) );
+    }
+
+    SECTION( "and rethrows exceptions which escaped them" )
+    {
+        fd_input_stream stream{ k_async_stream_small_path };
+        loop.spawn(DoAsyncFail(stream));
+
+        CHECK_THROWS_AS( loop.run(), io_exception );
+        CHECK( stream.position() == 4 );
+
+        // the loop stays usable afterwards
+        CHECK( loop.run(DoAsyncReadHeader(stream)) == 0x0CA86134u + 0x216Fu );
+    }
+}
+
+
+static task<int64_t> DoAsyncWriteTwice(output_stream& stream, weak_buffer input)
+{
+    const auto first = co_await async_write_bytes(stream, input);
+    const auto second = co_await async_write_bytes(stream, input);
+    co_return first + second;
+}
+
+TEST_CASE( "event loop runs tasks writing into streams", "[streams][async_streams][output_streams]" )
+{
+    event_loop loop{ { .m_worker_count = 1u } };
+    memory_output_stream stream{};
+    std::array<byte, 3u> junk{ 0x01, 0x02, 0x03 };
+
+    CHECK( loop.run(DoAsyncWriteTwice(stream, weak_buffer{ junk.data(), junk.size() })) == 6 );
+    CHECK( stream.position() == 6 );
+    CHECK( stream.length() == 6 );
+    CHECK( stream.view().data()[3] == 0x01 );
+    CHECK( stream.view().data()[5] == 0x03 );
+
+    CHECK_THROWS_AS( async_write_bytes(stream, weak_buffer{ nullptr, 3u }), io_exception );
+    CHECK_THROWS_AS( async_write_bytes(stream, weak_buffer{ junk.data(), 0u }), io_exception );
+}
+
+
+static task<void> DoAsyncReadOnce(input_stream& stream)
+{
+    std::array<byte, 16u> data{};
+    co_await async_read_bytes(stream, weak_buffer{ data.data(), data.size() });
+}
+
+static task<int> DoAsyncNothing()
+{
+    co_return 1;
+}
+
+TEST_CASE( "event loop waits for reads of unfinished tasks on destruction", "[streams][async_streams]" )
+{
+    // the fallback engine would execute the read of an empty pipe right away, and block
+    if (!io_engine::is_uring_supported())
+    {
+        SUCCEED( "io_uring is not supported by the current process" );
+        return;
+    }
+
+    int pipe_fds[2]{ -1, -1 };
+    REQUIRE( ::pipe(pipe_fds) == 0 );
+
+    fd_input_stream pending{ pipe_fds[0] };
+    fd_input_stream file{ k_async_stream_small_path };
+    std::vector<int64_t> sums(1u, 0);
+
+    {
+        event_loop loop{};
+
+        // the file read lets the loop return, while the pipe read stays in flight
+        loop.spawn(DoAsyncReadOnce(pending));
+        loop.spawn(DoAsyncSumFile(sums, 0u));
+        CHECK( loop.run(DoAsyncNothing()) == 1 );
+
+        CHECK( ::write(pipe_fds[1], "x", 1u) == 1 );
+    }
+
+    // the read completed before its buffer was freed, so nothing is left in the pipe
+    byte left = 0u;
+    ::fcntl(pipe_fds[0], F_SETFL, O_NONBLOCK);
+    CHECK( ::read(pipe_fds[0], &left, 1u) == -1 );
+    CHECK( pending.position() == 0 );
+
+    ::close(pipe_fds[1]);
+}
+
+
+TEST_CASE( "async operations can't be awaited outside of event loop", "[streams][async_streams]" )
+{
+    fd_input_stream stream{ k_async_stream_small_path };
+    std::array<byte, 4u> data{};
+
+    auto reading = DoAsyncReadAll(stream, weak_buffer{ data.data(), data.size() });
+    reading.handle().resume();
+
+    CHECK( reading.done() );
+    CHECK_THROWS_AS( reading.result(), io_exception );
+}
@@ -0,0 +1,418 @@
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+#include "reio/streams/buffered_streams.hpp"
+#include "reio/streams/memory_streams.hpp"
+using namespace reio;
+
+
+///
+/// Pass-through input stream which counts calls into the wrapped stream,
+/// used to check that buffered streams actually coalesce reads.
+///
+class counting_input_stream final : public input_stream
+{
+public:
+
+    input_stream*   m_inner;
+    int             m_reads = 0;
+    int             m_seeks = 0;
+
+    explicit counting_input_stream(input_stream* inner) : m_inner{ inner } {}
+
+    int64_t position() override { return m_inner->position(); }
+    int64_t length() override { return m_inner->length(); }
+    void seek_begin(int64_t offset) override { ++m_seeks; m_inner->seek_begin(offset); }
+    void seek_current(int64_t offset) override { ++m_seeks; m_inner->seek_current(offset); }
+    void seek_end(int64_t offset) override { ++m_seeks; m_inner->seek_end(offset); }
+    int64_t read_bytes(weak_buffer output) override { ++m_reads; return m_inner->read_bytes(output); }
+};
+
+
+TEST_CASE( "buffered input stream can be initialized", "[streams][buffered_streams][input_streams]" )
+{
+    std::array<uint8_t, 19u> junk = { 0u };
+    memory_input_stream inner{ weak_buffer{ junk.data(), junk.size() } };
+
+    SECTION( "with a default window" )
+    {
+        buffered_input_stream stream{ &inner };
+        CHECK( stream.source() == &inner );
+        CHECK( stream.window_capacity() == k_default_buffered_window );
+        CHECK( stream.window().length() == 0 );
+        CHECK( stream.position() == 0 );
+        CHECK( stream.length() == static_cast<int64_t>(junk.size()) );
+    }
+
+    SECTION( "at the current position of the wrapped stream" )
+    {
+        inner.seek_begin(5);
+
+        buffered_input_stream stream{ &inner, 8u };
+        CHECK( stream.window_capacity() == 8u );
+        CHECK( stream.position() == 5 );
+    }
+
+    SECTION( "but not with invalid arguments" )
+    {
+        CHECK_THROWS_AS( buffered_input_stream( nullptr ), io_exception );
+        CHECK_THROWS_AS( buffered_input_stream( &inner, 0u ), io_exception );
+        CHECK_THROWS_AS( buffered_input_stream( &inner, 8u, nullptr ), io_exception );
+    }
+}
+
+
+TEST_CASE( "buffered input stream coalesces reads", "[streams][buffered_streams][input_streams]" )
+{
+    std::array<uint8_t, 64u> junk{};
+    std::iota(junk.begin(), junk.end(), uint8_t{ 0u });
+
+    memory_input_stream inner{ weak_buffer{ junk.data(), junk.size() } };
+    counting_input_stream counter{ &inner };
+    buffered_input_stream stream{ &counter, 16u };
+
+    SECTION( "of small reads within the window" )
+    {
+        CHECK( stream.read_numeric_or_fail<uint8_t>() == 0x00 );
+        CHECK( stream.read_numeric_or_fail<uint16_t, std::endian::big>() == 0x0102 );
+        CHECK( stream.read_numeric_or_fail<uint32_t, std::endian::big>() == 0x03040506 );
+        CHECK( stream.read_byte() == 0x07 );
+
+        CHECK( counter.m_reads == 1 );
+        CHECK( stream.position() == 8 );
+        CHECK( stream.window().length() == 16u );
+    }
+
+    SECTION( "of reads crossing the window's end" )
+    {
+        std::array<byte, 12u> data{};
+
+        CHECK( stream.read_bytes(weak_buffer{ data.data(), data.size() }) == 12 );
+        CHECK( stream.read_bytes(weak_buffer{ data.data(), data.size() }) == 12 );
+
+        CHECK( std::equal(data.begin(), data.end(), junk.begin() + 12) );
+        CHECK( counter.m_reads == 2 );
+        CHECK( stream.position() == 24 );
+    }
+
+    SECTION( "except the big ones" )
+    {
+        stream.read_byte();
+
+        std::array<byte, 40u> data{};
+        CHECK( stream.read_bytes(weak_buffer{ data.data(), data.size() }) == 40 );
+
+        // the remainder of the first window plus a single direct read
+        CHECK( std::equal(data.begin(), data.end(), junk.begin() + 1) );
+        CHECK( counter.m_reads == 2 );
+        CHECK( stream.position() == 41 );
+        CHECK( stream.read_byte() == 41 );
+    }
+
+    SECTION( "and reports the end of the data" )
+    {
+        std::array<byte, 100u> data{};
+
+        CHECK( stream.read_bytes(weak_buffer{ data.data(), data.size() }) == 64 );
+        CHECK( std::equal(junk.begin(), junk.end(), data.begin()) );
+        CHECK( stream.read_byte() == -1 );
+
+        uint32_t num_junk;
+        CHECK( !stream.read_numeric<uint32_t>(num_junk) );
+
+        CHECK_THROWS_AS( stream.read_bytes(weak_buffer{ nullptr, 4u }), io_exception );
+        CHECK_THROWS_AS( stream.read_bytes(weak_buffer{ data.data(), 0u }), io_exception );
+    }
+}
+
+
+TEST_CASE( "buffered input stream falls back to copying views", "[streams][buffered_streams][input_streams]" )
+{
+    std::array<uint8_t, 64u> junk{};
+    std::iota(junk.begin(), junk.end(), uint8_t{ 0u });
+
+    memory_input_stream inner{ weak_buffer{ junk.data(), junk.size() } };
+    buffered_input_stream stream{ &inner, 16u };
+
+    CHECK( !stream.try_read_view(4u).has_value() );
+    CHECK( stream.position() == 0 );
+
+    owning_buffer scratch{ 2u };
+    const auto view = stream.read_view(24u, scratch);
+
+    CHECK( view.data() == scratch.data() );
+    CHECK( view.length() == 24u );
+    CHECK( std::equal(view.begin(), view.end(), junk.begin()) );
+    CHECK( stream.position() == 24 );
+
+    stream.seek_end(-4);
+    CHECK( stream.read_view(24u, scratch).length() == 4u );
+    CHECK( stream.read_view(0u, scratch).length() == 0u );
+}
+
+
+TEST_CASE( "buffered input stream can be seeked", "[streams][buffered_streams][input_streams]" )
+{
+    std::array<uint8_t, 64u> junk{};
+    std::iota(junk.begin(), junk.end(), uint8_t{ 0u });
+
+    memory_input_stream inner{ weak_buffer{ junk.data(), junk.size() } };
+    counting_input_stream counter{ &inner };
+    buffered_input_stream stream{ &counter, 16u };
+
+    // fill the window with [0; 16)
+    stream.read_byte();
+
+    SECTION( "within the window without a refill" )
+    {
+        stream.seek_begin(10);
+        CHECK( stream.position() == 10 );
+        CHECK( stream.read_byte() == 10 );
+
+        stream.seek_current(-8);
+        CHECK( stream.position() == 3 );
+        CHECK( stream.read_byte() == 3 );
+
+        CHECK( counter.m_reads == 1 );
+        CHECK( counter.m_seeks == 0 );
+    }
+
+    SECTION( "outside the window by refilling it" )
+    {
+        stream.seek_begin(40);
+        CHECK( stream.position() == 40 );
+        CHECK( stream.read_byte() == 40 );
+
+        stream.seek_current(-30);
+        CHECK( stream.position() == 11 );
+        CHECK( stream.read_byte() == 11 );
+
+        stream.seek_end(-4);
+        CHECK( stream.position() == 60 );
+        CHECK( stream.read_byte() == 60 );
+
+        CHECK( counter.m_reads == 4 );
+        CHECK( counter.m_seeks == 3 );
+    }
+
+    SECTION( "with the wrapped stream's bounds checks" )
+    {
+        CHECK_THROWS_AS( stream.seek_begin(-1), io_exception );
+        CHECK_THROWS_AS( stream.seek_begin(100), io_exception );
+        CHECK_THROWS_AS( stream.seek_current(100), io_exception );
+        CHECK_THROWS_AS( stream.seek_end(1), io_exception );
+    }
+}
+
+
+
+
+
+///
+/// Pass-through output stream which counts calls into the wrapped stream,
+/// used to check that buffered streams actually coalesce writes.
+/// Writes throw once @c m_failing is set.
+///
+class counting_output_stream final : public output_stream
+{
+public:
+
+    output_stream*  m_inner;
+    int             m_writes = 0;
+    int             m_seeks = 0;
+    bool            m_failing = false;
+
+    explicit counting_output_stream(output_stream* inner) : m_inner{ inner } {}
+
+    int64_t position() override { return m_inner->position(); }
+    int64_t length() override { return m_inner->length(); }
+    void seek_begin(int64_t offset) override { ++m_seeks; m_inner->seek_begin(offset); }
+    void seek_current(int64_t offset) override { ++m_seeks; m_inner->seek_current(offset); }
+    void seek_end(int64_t offset) override { ++m_seeks; m_inner->seek_end(offset); }
+    int64_t write_bytes(weak_buffer input) override
+    {
+        ++m_writes;
+        if (m_failing)
+        {
+            REIO_FAIL("counting output stream failed on purpose", __FILE__, __LINE__, _REIO_FUNC_);
+        }
+        return m_inner->write_bytes(input);
+    }
+};
+
+
+TEST_CASE( "buffered output stream can be initialized", "[streams][buffered_streams][output_streams]" )
+{
+    memory_output_stream inner{};
+
+    SECTION( "with a default window" )
+    {
+        buffered_output_stream stream{ &inner };
+        CHECK( stream.sink() == &inner );
+        CHECK( stream.window_capacity() == k_default_buffered_window );
+        CHECK( stream.window().length() == 0 );
+        CHECK( stream.position() == 0 );
+        CHECK( stream.length() == 0 );
+    }
+
+    SECTION( "but not with invalid arguments" )
+    {
+        CHECK_THROWS_AS( buffered_output_stream( nullptr ), io_exception );
+        CHECK_THROWS_AS( buffered_output_stream( &inner, 0u ), io_exception );
+        CHECK_THROWS_AS( buffered_output_stream( &inner, 8u, nullptr ), io_exception );
+    }
+}
+
+
+TEST_CASE( "buffered output stream coalesces writes", "[streams][buffered_streams][output_streams]" )
+{
+    memory_output_stream inner{};
+    counting_output_stream counter{ &inner };
+
+    SECTION( "of small writes until the window fills up" )
+    {
+        buffered_output_stream stream{ &counter, 16u };
+
+        for (auto i = 0u; i < 10u; i++)
+        {
+            stream.write_numeric_or_fail<uint32_t, std::endian::big>(i);
+        }
+
+        CHECK( counter.m_writes == 2 );
+        CHECK( inner.length() == 32 );
+        CHECK( stream.position() == 40 );
+        CHECK( stream.length() == 40 );
+
+        stream.flush();
+
+        CHECK( counter.m_writes == 3 );
+        CHECK( inner.length() == 40 );
+        CHECK( stream.window().length() == 0 );
+    }
+
+    SECTION( "except the big ones" )
+    {
+        buffered_output_stream stream{ &counter, 16u };
+        std::array<byte, 20u> data{};
+        std::iota(data.begin(), data.end(), byte{ 1u });
+
+        CHECK( stream.write_byte(0u) );
+        CHECK( stream.write_bytes(weak_buffer{ data.data(), data.size() }) == 20 );
+
+        // the pending byte is flushed first to keep the order intact
+        CHECK( counter.m_writes == 2 );
+        CHECK( inner.length() == 21 );
+        CHECK( stream.position() == 21 );
+        CHECK( std::ranges::equal(inner.view().last(20), data) );
+    }
+
+    SECTION( "and flushes them on destruction" )
+    {
+        {
+            buffered_output_stream stream{ &counter, 16u };
+            stream.write_numeric_or_fail<uint16_t, std::endian::little>(0x0102);
+            CHECK( inner.length() == 0 );
+        }
+
+        CHECK( counter.m_writes == 1 );
+        CHECK( std::ranges::equal(inner.view(), std::array<uint8_t, 2u>{ 0x02, 0x01 }) );
+    }
+
+    SECTION( "and reports failures of the wrapped stream on flush" )
+    {
+        memory_output_stream fixed{ 4u, growth_factor::none };
+        buffered_output_stream stream{ &fixed, 16u };
+
+        CHECK( stream.write_numeric<uint64_t>(0u) );
+        CHECK_THROWS_AS( stream.flush(), io_exception );
+
+        CHECK_THROWS_AS( stream.write_bytes(weak_buffer{ nullptr, 4u }), io_exception );
+    }
+
+    SECTION( "and swallows failures of the wrapped stream on destruction" )
+    {
+        memory_output_stream inner{};
+        counting_output_stream failing{ &inner };
+
+        {
+            buffered_output_stream stream{ &failing, 16u };
+            CHECK( stream.write_numeric<uint32_t>(1u) );
+            failing.m_failing = true;
+        }
+
+        CHECK( failing.m_writes == 1 );
+        CHECK( inner.length() == 0 );
+    }
+}
+
+
+TEST_CASE( "buffered output stream can be seeked", "[streams][buffered_streams][output_streams]" )
+{
+    memory_output_stream inner{};
+    counting_output_stream counter{ &inner };
+    buffered_output_stream stream{ &counter, 16u };
+
+    SECTION( "within the pending window by patching it" )
+    {
+        stream.write_numeric_or_fail<uint32_t>(0u);
+        stream.write_numeric_or_fail<uint32_t, std::endian::big>(0xAABBCCDD);
+
+        stream.seek_begin(0);
+        stream.write_numeric_or_fail<uint16_t, std::endian::big>(0x0102);
+        stream.seek_current(6);
+        CHECK( stream.position() == 8 );
+
+        stream.write_byte(0xEE);
+        stream.seek_current(-2);
+        stream.write_byte(0xFF);
+
+        CHECK( counter.m_writes == 0 );
+        CHECK( counter.m_seeks == 0 );
+        CHECK( stream.position() == 8 );
+        CHECK( stream.length() == 9 );
+
+        stream.flush();
+
+        // the wrapped stream has to follow the cursor, not the end of the window
+        CHECK( inner.position() == 8 );
+        CHECK( std::ranges::equal(inner.view(), std::array<uint8_t, 9u>{
+            0x01, 0x02, 0x00, 0x00, 0xAA, 0xBB, 0xCC, 0xFF, 0xEE
+        }) );
+    }
+
+    SECTION( "outside the pending window by flushing it" )
+    {
+        for (auto i = 0u; i < 6u; i++)
+        {
+            stream.write_numeric_or_fail<uint32_t, std::endian::big>(i);
+        }
+
+        // [0; 16) is flushed, [16; 24) is pending
+        stream.seek_begin(4);
+        CHECK( counter.m_writes == 2 );
+        CHECK( stream.position() == 4 );
+
+        stream.write_numeric_or_fail<uint32_t, std::endian::big>(0xFFFFFFFF);
+        stream.seek_end(-4);
+        CHECK( stream.position() == 20 );
+
+        stream.write_numeric_or_fail<uint32_t, std::endian::big>(0xEEEEEEEE);
+        stream.flush();
+
+        CHECK( std::ranges::equal(inner.view(), std::array<uint8_t, 24u>{
+            0x00, 0x00, 0x00, 0x00,  0xFF, 0xFF, 0xFF, 0xFF,  0x00, 0x00, 0x00, 0x02,
+            0x00, 0x00, 0x00, 0x03,  0x00, 0x00, 0x00, 0x04,  0xEE, 0xEE, 0xEE, 0xEE
+        }) );
+    }
+
+    SECTION( "with the wrapped stream's bounds checks" )
+    {
+        stream.write_numeric_or_fail<uint32_t>(0u);
+
+        CHECK_THROWS_AS( stream.seek_begin(-1), io_exception );
+        CHECK_THROWS_AS( stream.seek_begin(100), io_exception );
+        CHECK_THROWS_AS( stream.seek_current(100), io_exception );
+        CHECK_THROWS_AS( stream.seek_end(1), io_exception );
+    }
+}
@@ -0,0 +1,92 @@
+#include <array>
+#include <fcntl.h>
+
+#include "reio/streams/engine_streams.hpp"
+using namespace reio;
+
+
+static constexpr auto k_engine_stream_small_path = REIO_TESTS_DATA_DIR "/small.bin";
+
+
+TEST_CASE( "engine input stream can be initialized", "[streams][engine_streams][input_streams]" )
+{
+    SECTION( "from a file path" )
+    {
+        engine_input_stream stream{ k_engine_stream_small_path };
+
+        CHECK( stream.fd() >= 0 );
+        CHECK( stream.position() == 0 );
+        CHECK( stream.length() == 19 );
+        CHECK( (stream.engine().backend() == io_backend::uring) == io_engine::is_uring_supported() );
+    }
+
+    SECTION( "from a descriptor, at its offset" )
+    {
+        const int fd = ::open(k_engine_stream_small_path, O_RDONLY);
+        REQUIRE( fd >= 0 );
+        REQUIRE( ::lseek(fd, 4, SEEK_SET) == 4 );
+
+        engine_input_stream stream{ fd, { .m_force_fallback = true } };
+
+        CHECK( stream.position() == 4 );
+        CHECK( stream.engine().backend() == io_backend::pread );
+        CHECK( stream.read_byte() == 0x0C );
+    }
+
+    SECTION( "but not from a missing file or an invalid descriptor" )
+    {
+        CHECK_THROWS_AS( engine_input_stream{ REIO_TESTS_DATA_DIR "/missing.bin" }, io_exception );
+        CHECK_THROWS_AS( engine_input_stream{ -1 }, io_exception );
+    }
+}
+
+
+TEST_CASE( "engine input stream deserializes primitives", "[streams][engine_streams][input_streams]" )
+{
+    const auto force_fallback = GENERATE( false, true );
+    engine_input_stream stream{ k_engine_stream_small_path, 0, { .m_queue_depth = 2u, .m_force_fallback = force_fallback } };
+
+    SECTION( "of arbitrary buffers" )
+    {
+        std::array<byte, 100> data{};
+
+        CHECK( stream.read_bytes(weak_buffer{ data.data(), 4u }) == 4 );
+        CHECK( stream.read_bytes(weak_buffer{ data.data() + 4u, data.size() - 4u }) == 15 );
+        CHECK( data[18] == 0x01 );
+        CHECK( stream.position() == 19 );
+        CHECK( stream.read_byte() == -1 );
+
+        CHECK_THROWS_AS( stream.read_bytes(weak_buffer{ nullptr, 4u }), io_exception );
+        CHECK_THROWS_AS( stream.read_bytes(weak_buffer{ data.data(), 0u }), io_exception );
+    }
+
+    SECTION( "of numbers in big-endian" )
+    {
+        stream.seek_begin(4);
+
+        CHECK( stream.read_numeric_or_fail<uint8_t, std::endian::big>() == 12u );
+        CHECK( stream.read_numeric_or_fail<uint16_t, std::endian::big>() == 43105u );
+        CHECK( stream.read_numeric_or_fail<uint32_t, std::endian::big>() == 874606462u );
+        CHECK( stream.read_numeric_or_fail<uint64_t, std::endian::big>() == 5688944245090268673u );
+
+        CHECK_THROWS( stream.read_numeric_or_fail<uint32_t, std::endian::big>() );
+    }
+
+    SECTION( "of scattered buffers, in batches" )
+    {
+        std::array<byte, 12u> data{};
+        std::array<weak_buffer, 5u> outputs = {
+            weak_buffer{ data.data(), 2u },
+            weak_buffer{ data.data() + 2u, 0u },
+            weak_buffer{ data.data() + 2u, 3u },
+            weak_buffer{ data.data() + 5u, 3u },
+            weak_buffer{ data.data() + 8u, 4u }
+        };
+
+        stream.seek_end(-10);
+        CHECK( stream.read_bytes_scatter(outputs) == 10 );
+        CHECK( data[0] == 0x6F );
+        CHECK( data[9] == 0x01 );
+        CHECK( stream.position() == 19 );
+    }
+}
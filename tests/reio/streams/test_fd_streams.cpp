@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+#include "reio/streams/fd_streams.hpp"
+using namespace reio;
+
+
+static constexpr auto k_fd_small_path = REIO_TESTS_DATA_DIR "/small.bin";
+
+
+TEST_CASE( "fd input stream can be initialized", "[streams][fd_streams][input_streams]" )
+{
+    SECTION( "from a file path" )
+    {
+        fd_input_stream stream{ k_fd_small_path };
+
+        CHECK( stream.fd() >= 0 );
+        CHECK( stream.position() == 0 );
+        CHECK( stream.length() == 19 );
+    }
+
+    SECTION( "from a descriptor, at its offset" )
+    {
+        const int fd = ::open(k_fd_small_path, O_RDONLY);
+        REQUIRE( fd >= 0 );
+        REQUIRE( ::lseek(fd, 4, SEEK_SET) == 4 );
+
+        fd_input_stream stream{ fd };
+
+        CHECK( stream.fd() == fd );
+        CHECK( stream.position() == 4 );
+        CHECK( stream.read_byte() == 0x0C );
+
+        // the descriptor's own offset is never touched
+        CHECK( ::lseek(fd, 0, SEEK_CUR) == 4 );
+    }
+
+    SECTION( "by move-constructor" )
+    {
+        fd_input_stream origin{ k_fd_small_path };
+        origin.seek_begin(3);
+
+        const auto fd = origin.fd();
+        fd_input_stream target{ std::move(origin) };
+
+        CHECK( target.fd() == fd );
+        CHECK( target.position() == 3 );
+        CHECK( origin.fd() == -1 );
+    }
+
+    SECTION( "with the descriptor released" )
+    {
+        fd_input_stream stream{ k_fd_small_path };
+        const auto fd = stream.release();
+
+        CHECK( stream.fd() == -1 );
+        CHECK( ::close(fd) == 0 );
+    }
+
+    SECTION( "but not from a missing file or an invalid descriptor" )
+    {
+        CHECK_THROWS_AS( fd_input_stream{ REIO_TESTS_DATA_DIR "/missing.bin" }, io_exception );
+        CHECK_THROWS_AS( fd_input_stream{ -1 }, io_exception );
+    }
+}
+
+
+TEST_CASE( "fd input stream deserializes primitives", "[streams][fd_streams][input_streams]" )
+{
+    fd_input_stream stream{ k_fd_small_path };
+
+    SECTION( "of arbitrary buffers" )
+    {
+        std::array<byte, 100> data{};
+
+        CHECK( stream.read_bytes(weak_buffer{ data.data(), 4u }) == 4 );
+        CHECK( stream.read_bytes(weak_buffer{ data.data() + 4u, data.size() - 4u }) == 15 );
+        CHECK( data[18] == 0x01 );
+        CHECK( stream.position() == 19 );
+        CHECK( stream.read_byte() == -1 );
+
+        CHECK_THROWS_AS( stream.read_bytes(weak_buffer{ nullptr, 4u }), io_exception );
+        CHECK_THROWS_AS( stream.read_bytes(weak_buffer{ data.data(), 0u }), io_exception );
+    }
+
+    SECTION( "of numbers in big-endian" )
+    {
+        stream.seek_begin(4);
+
+        CHECK( stream.read_numeric_or_fail<uint8_t, std::endian::big>() == 12u );
+        CHECK( stream.read_numeric_or_fail<uint16_t, std::endian::big>() == 43105u );
+        CHECK( stream.read_numeric_or_fail<uint32_t, std::endian::big>() == 874606462u );
+        CHECK( stream.read_numeric_or_fail<uint64_t, std::endian::big>() == 5688944245090268673u );
+
+        CHECK_THROWS( stream.read_numeric_or_fail<uint32_t, std::endian::big>() );
+    }
+
+    SECTION( "of scattered buffers" )
+    {
+        std::array<byte, 8u> data{};
+        std::array<weak_buffer, 2u> outputs = {
+            weak_buffer{ data.data(), 3u },
+            weak_buffer{ data.data() + 3u, 5u }
+        };
+
+        stream.seek_end(-6);
+        CHECK( stream.read_bytes_scatter(outputs) == 6 );
+        CHECK( data[0] == 0x30 );
+        CHECK( data[5] == 0x01 );
+        CHECK( stream.position() == 19 );
+    }
+
+    SECTION( "at arbitrary offsets" )
+    {
+        std::array<byte, 4u> data{};
+
+        CHECK( stream.size() == 19 );
+        CHECK( stream.read_at(4, weak_buffer{ data.data(), data.size() }) == 4 );
+        CHECK( data == std::array<byte, 4u>{ 0x0C, 0xA8, 0x61, 0x34 } );
+        CHECK( stream.read_at(17, weak_buffer{ data.data(), data.size() }) == 2 );
+        CHECK( stream.read_at(19, weak_buffer{ data.data(), data.size() }) == 0 );
+        CHECK( stream.position() == 0 );
+
+        CHECK( !stream.view_at(0, 4u).has_value() );
+        CHECK_THROWS_AS( stream.read_at(-1, weak_buffer{ data.data(), data.size() }), io_exception );
+    }
+}
+
+
+TEST_CASE( "fd streams can be seeked", "[streams][fd_streams]" )
+{
+    fd_input_stream stream{ k_fd_small_path };
+
+    stream.seek_begin(3);
+    CHECK( stream.position() == 3 );
+
+    stream.seek_current(10);
+    CHECK( stream.position() == 13 );
+
+    stream.seek_end(-5);
+    CHECK( stream.position() == 14 );
+
+    // past the end is allowed, like with CRT streams
+    stream.seek_end(5);
+    CHECK( stream.position() == 24 );
+    CHECK( stream.read_byte() == -1 );
+
+    CHECK_THROWS_AS( stream.seek_begin(-1), io_exception );
+    CHECK_THROWS_AS( stream.seek_current(-100), io_exception );
+    CHECK_THROWS_AS( stream.seek_end(-20), io_exception );
+}
+
+
+TEST_CASE( "fd output stream serializes primitives", "[streams][fd_streams][output_streams]" )
+{
+    const auto path = (std::filesystem::temp_directory_path() / "reio_test_fd_streams.bin").string();
+
+    {
+        fd_output_stream stream{ path };
+
+        CHECK( stream.position() == 0 );
+        CHECK( stream.length() == 0 );
+
+        stream.write_numeric_or_fail<uint32_t, std::endian::big>(0x01020304u);
+        stream.write_byte(0x05);
+        CHECK( stream.position() == 5 );
+        CHECK( stream.length() == 5 );
+
+        // back-patching
+        stream.seek_begin(1);
+        stream.write_byte(0xAA);
+        CHECK( stream.position() == 2 );
+        CHECK( stream.length() == 5 );
+
+        // writing past the end leaves a hole
+        stream.seek_end(3);
+        std::array<byte, 4u> tail = { 0x0A, 0x0B, 0x0C, 0x0D };
+        std::array<weak_buffer, 2u> parts = {
+            weak_buffer{ tail.data(), 1u },
+            weak_buffer{ tail.data() + 1u, 3u }
+        };
+        CHECK( stream.write_bytes_gather(parts) == 4 );
+        CHECK( stream.length() == 12 );
+    }
+
+    {
+        fd_input_stream stream{ path };
+        std::array<byte, 12u> data{};
+
+        CHECK( stream.read_bytes(weak_buffer{ data.data(), data.size() }) == 12 );
+        CHECK( data == std::array<byte, 12u>{ 0x01, 0xAA, 0x03, 0x04, 0x05, 0, 0, 0, 0x0A, 0x0B, 0x0C, 0x0D } );
+    }
+
+    CHECK_THROWS_AS( fd_output_stream( path, O_APPEND ), io_exception );
+    std::filesystem::remove(path);
+}
+
+
+TEST_CASE( "fd streams cache file length", "[streams][fd_streams]" )
+{
+    const auto path = (std::filesystem::temp_directory_path() / "reio_test_fd_length.bin").string();
+    std::array<byte, 8u> junk = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    fd_output_stream output{ path };
+    output.write_bytes(weak_buffer{ junk.data(), junk.size() });
+
+    fd_input_stream input{ path };
+    CHECK( input.length() == 8 );
+
+    output.write_bytes(weak_buffer{ junk.data(), junk.size() });
+    CHECK( output.length() == 16 );
+
+    // the reader only notices after a refresh
+    CHECK( input.length() == 8 );
+    CHECK( input.refresh_length() == 16 );
+    CHECK( input.length() == 16 );
+
+    input.seek_end(-1);
+    CHECK( input.read_byte() == 8 );
+
+    // changes made behind the stream's back
+    REQUIRE( ::ftruncate(output.fd(), 4) == 0 );
+    CHECK( output.length() == 16 );
+    CHECK( output.refresh_length() == 4 );
+
+    std::filesystem::remove(path);
+}
+
+
+#ifdef O_DIRECT
+
+TEST_CASE( "fd streams bypass page cache with O_DIRECT", "[streams][fd_streams]" )
+{
+    const auto path = (std::filesystem::temp_directory_path() / "reio_test_fd_direct.bin").string();
+
+    // not every file system supports direct I/O, e.g. tmpfs doesn't
+    const int probe = ::open(path.c_str(), O_RDWR | O_CREAT | O_DIRECT, 0644);
+    if (probe == -1)
+    {
+        std::filesystem::remove(path);
+        SUCCEED( "direct I/O is not supported by the temporary directory" );
+        return;
+    }
+    ::close(probe);
+
+    // reference contents, which are mirrored into the file
+    std::vector<byte> expected(3u * k_direct_io_alignment + 100u);
+    for (std::size_t i = 0u; i < expected.size(); i++)
+    {
+        expected[i] = static_cast<byte>(i * 7u + 1u);
+    }
+
+    owning_buffer aligned{ 2u * k_direct_io_alignment, aligned_allocator::get_default() };
+    aligned.insert(expected.begin() + 10, expected.begin() + 10 + 2 * k_direct_io_alignment, aligned.end());
+
+    {
+        fd_output_stream stream{ path, O_DIRECT };
+        CHECK( stream.is_direct() );
+
+        // unaligned head, aligned bulk which isn't at an aligned offset, and an unaligned tail
+        CHECK( stream.write_bytes(weak_buffer{ expected.data(), 10u }) == 10 );
+        CHECK( stream.write_bytes(aligned.view()) == static_cast<int64_t>(aligned.length()) );
+        CHECK( stream.write_bytes(weak_buffer{ expected.data() + aligned.length() + 10u, expected.size() - aligned.length() - 10u }) > 0 );
+        CHECK( stream.position() == static_cast<int64_t>(expected.size()) );
+        CHECK( stream.length() == static_cast<int64_t>(expected.size()) );
+
+        // back-patching within a block which was already written
+        stream.seek_begin(9000);
+        std::array<byte, 3u> patch = { 0xAA, 0xBB, 0xCC };
+        stream.write_bytes(weak_buffer{ patch.data(), patch.size() });
+        std::copy(patch.begin(), patch.end(), expected.begin() + 9000);
+
+        // buffered bytes reach the file on flush, without padding
+        CHECK( stream.refresh_length() == static_cast<int64_t>(expected.size()) );
+        CHECK( std::filesystem::file_size(path) == expected.size() );
+
+        // writing from aligned memory to an aligned offset goes straight to the file
+        stream.seek_begin(static_cast<int64_t>(k_direct_io_alignment));
+        stream.write_bytes(aligned.first(k_direct_io_alignment));
+        std::copy_n(aligned.data(), k_direct_io_alignment, expected.begin() + k_direct_io_alignment);
+    }
+
+    {
+        fd_input_stream stream{ path };
+        std::vector<byte> data(expected.size() + 10u);
+
+        CHECK( !stream.is_direct() );
+        CHECK( stream.read_bytes(weak_buffer{ data.data(), data.size() }) == static_cast<int64_t>(expected.size()) );
+        CHECK( std::equal(expected.begin(), expected.end(), data.begin()) );
+    }
+
+    {
+        fd_input_stream stream{ path, O_DIRECT };
+        std::array<byte, 100u> data{};
+
+        CHECK( stream.is_direct() );
+
+        SECTION( "with unaligned reads" )
+        {
+            stream.seek_begin(4090);
+            CHECK( stream.read_bytes(weak_buffer{ data.data(), 20u }) == 20 );
+            CHECK( std::equal(data.begin(), data.begin() + 20, expected.begin() + 4090) );
+            CHECK( stream.position() == 4110 );
+        }
+
+        SECTION( "with aligned reads" )
+        {
+            owning_buffer output{ k_direct_io_alignment, aligned_allocator::get_default() };
+            output.resize_to_capacity();
+
+            stream.seek_begin(static_cast<int64_t>(k_direct_io_alignment));
+            CHECK( stream.read_bytes(output.view()) == static_cast<int64_t>(k_direct_io_alignment) );
+            CHECK( std::equal(output.begin(), output.end(), expected.begin() + k_direct_io_alignment) );
+        }
+
+        SECTION( "with the file tail" )
+        {
+            stream.seek_end(-30);
+            CHECK( stream.read_bytes(weak_buffer{ data.data(), data.size() }) == 30 );
+            CHECK( std::equal(data.begin(), data.begin() + 30, expected.end() - 30) );
+            CHECK( stream.read_byte() == -1 );
+        }
+
+        SECTION( "at arbitrary offsets" )
+        {
+            CHECK( stream.read_at(8999, weak_buffer{ data.data(), 5u }) == 5 );
+            CHECK( data[1] == 0xAA );
+            CHECK( data[3] == 0xCC );
+            CHECK( stream.read_at(static_cast<int64_t>(expected.size()) - 2, weak_buffer{ data.data(), 5u }) == 2 );
+            CHECK( stream.position() == 0 );
+        }
+    }
+
+    std::filesystem::remove(path);
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+
+#include "reio/streams/file_streams.hpp"
+using namespace reio;
+
+
+TEST_CASE( "file streams transfer sequences of buffers", "[streams][file_streams]" )
+{
+    const auto path = (std::filesystem::temp_directory_path() / "reio_test_file_streams.bin").string();
+
+    std::array<byte, 300u> junk{};
+    std::iota(junk.begin(), junk.end(), byte{ 0u });
+
+    // more parts than fit into a single vectored call
+    std::array<weak_buffer, 150u> parts{};
+    for (std::size_t i = 0u; i < parts.size(); i++)
+    {
+        parts[i] = weak_buffer{ junk.data() + i * 2u, 2u };
+    }
+
+    {
+        file_output_stream output{ path };
+
+        // buffered CRT output must land before the gathered block
+        output.write_numeric<uint32_t, std::endian::big>(0xAABBCCDDu);
+
+        CHECK( output.write_bytes_gather(parts) == 300 );
+        CHECK( output.position() == 304 );
+
+        output.write_byte(0xEE);
+        CHECK( output.length() == 305 );
+    }
+
+    {
+        file_input_stream input{ path };
+        CHECK( input.length() == 305 );
+
+        // fills the CRT read-ahead, so the vectored read has to start at the logical position
+        CHECK( input.read_numeric_or_fail<uint32_t, std::endian::big>() == 0xAABBCCDDu );
+
+        std::array<byte, 300u> back{};
+        std::array<weak_buffer, 3u> outputs = {
+            weak_buffer{ back.data(), 100u },
+            weak_buffer{ back.data() + 100u, 150u },
+            weak_buffer{ back.data() + 250u, 50u }
+        };
+
+        CHECK( input.read_bytes_scatter(outputs) == 300 );
+        CHECK( back == junk );
+        CHECK( input.position() == 304 );
+        CHECK( input.read_byte() == 0xEE );
+
+        input.seek_begin(302);
+        CHECK( input.read_bytes_scatter(outputs) == 3 );
+        CHECK( back[2] == 0xEE );
+        CHECK( input.read_byte() == -1 );
+    }
+
+    std::filesystem::remove(path);
+}
+
+
+TEST_CASE( "file streams cache file length", "[streams][file_streams]" )
+{
+    const auto path = (std::filesystem::temp_directory_path() / "reio_test_file_length.bin").string();
+    std::array<byte, 8u> junk = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    {
+        file_output_stream output{ path };
+        CHECK( output.length() == 0 );
+
+        output.write_bytes(weak_buffer{ junk.data(), junk.size() });
+        CHECK( output.position() == 8 );
+        CHECK( output.length() == 8 );
+
+        output.seek_begin(2);
+        output.write_bytes(weak_buffer{ junk.data(), 4u });
+        CHECK( output.position() == 6 );
+        CHECK( output.length() == 8 );
+
+        output.seek_current(-6);
+        CHECK( output.position() == 0 );
+
+        output.seek_end(0);
+        output.write_bytes(weak_buffer{ junk.data(), junk.size() });
+        CHECK( output.position() == 16 );
+        CHECK( output.length() == 16 );
+        CHECK( output.refresh_length() == 16 );
+    }
+
+    file_input_stream input{ path };
+    CHECK( input.length() == 16 );
+
+    {
+        // appended to behind the reader's back
+        const auto file = std::fopen(path.c_str(), "ab");
+        REQUIRE( file != nullptr );
+        std::fwrite(junk.data(), 1u, 4u, file);
+        std::fclose(file);
+    }
+
+    CHECK( input.length() == 16 );
+    CHECK( input.refresh_length() == 20 );
+
+    input.seek_end(-1);
+    CHECK( input.read_byte() == 4 );
+
+    std::filesystem::remove(path);
+}
+
+
+TEST_CASE( "file streams track position of append-mode handles", "[streams][file_streams]" )
+{
+    const auto path = (std::filesystem::temp_directory_path() / "reio_test_file_append.bin").string();
+    std::array<byte, 8u> junk = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    {
+        file_output_stream output{ path };
+        output.write_bytes(weak_buffer{ junk.data(), 7u });
+    }
+
+    {
+        const auto file = std::fopen(path.c_str(), "ab");
+        REQUIRE( file != nullptr );
+
+        file_output_stream output{ file };
+        CHECK( output.length() == 7 );
+
+        // writes land at the end of file, wherever the stream was seeked to
+        output.seek_begin(0);
+        output.write_bytes(weak_buffer{ junk.data(), 1u });
+        CHECK( output.position() == 8 );
+        CHECK( output.length() == 8 );
+
+        std::array<weak_buffer, 2u> inputs{ weak_buffer{ junk.data(), 2u }, weak_buffer{ junk.data(), 3u } };
+        output.seek_begin(1);
+        CHECK( output.write_bytes_gather(inputs) == 5 );
+        CHECK( output.position() == 13 );
+        CHECK( output.length() == 13 );
+        CHECK( output.refresh_length() == 13 );
+    }
+
+    file_input_stream input{ path };
+    CHECK( input.length() == 13 );
+
+    input.seek_begin(7);
+    CHECK( input.read_byte() == 1 );
+
+    std::filesystem::remove(path);
+}
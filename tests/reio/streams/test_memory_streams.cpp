@@ -283,6 +283,132 @@ TEST_CASE( "memory input stream deserializes primitives", "[streams][memory_stre
     }
 }
 
+TEST_CASE( "memory input stream lends views of its data", "[streams][memory_streams][input_streams]" )
+{
+    std::array<uint8_t, 19u> junk = {
+        0x01, 0x02, 0x03, 0x04,
+        0x0C,
+        0xA8, 0x61,
+        0x34, 0x21, 0x6F, 0x7E,
+        0x4E, 0xF3, 0x30, 0xA6, 0x4B, 0x9B, 0xB6, 0x01
+    };
+
+    memory_input_stream stream{ weak_buffer{ junk.data(), junk.size() } };
+
+    SECTION( "without copying" )
+    {
+        const auto view = stream.try_read_view(4u);
+
+        REQUIRE( view.has_value() );
+        CHECK( view->data() == stream.view().data() );
+        CHECK( std::ranges::equal(*view, std::array<uint8_t, 4u>{ 0x01, 0x02, 0x03, 0x04 }) );
+        CHECK( stream.position() == 4 );
+    }
+
+    SECTION( "which are cut at the end of the data" )
+    {
+        stream.seek_begin(15);
+
+        const auto view = stream.try_read_view(100u);
+
+        REQUIRE( view.has_value() );
+        CHECK( view->length() == 4u );
+        CHECK( stream.position() == 19 );
+
+        CHECK( stream.try_read_view(4u)->length() == 0u );
+    }
+
+    SECTION( "without touching the scratch buffer" )
+    {
+        owning_buffer scratch{};
+        const auto view = stream.read_view(7u, scratch);
+
+        CHECK( view.data() == stream.view().data() );
+        CHECK( view.length() == 7u );
+        CHECK( scratch.capacity() == 0u );
+    }
+}
+
+
+TEST_CASE( "view input stream reads without copying", "[streams][memory_streams][input_streams]" )
+{
+    std::array<uint8_t, 19u> junk = {
+        0x01, 0x02, 0x03, 0x04,
+        0x0C,
+        0xA8, 0x61,
+        0x34, 0x21, 0x6F, 0x7E,
+        0x4E, 0xF3, 0x30, 0xA6, 0x4B, 0x9B, 0xB6, 0x01
+    };
+
+    view_input_stream stream{ weak_buffer{ junk.data(), junk.size() } };
+
+    SECTION( "when initialized" )
+    {
+        CHECK( stream.view().data() == junk.data() );
+        CHECK( stream.position() == 0 );
+        CHECK( stream.length() == junk.size() );
+
+        CHECK_THROWS_AS( view_input_stream( weak_buffer{ nullptr, 4u } ), io_exception );
+        CHECK_THROWS_AS( view_input_stream( weak_buffer{ junk.data(), 0u } ), io_exception );
+    }
+
+    SECTION( "when moved" )
+    {
+        stream.seek_begin(3);
+        view_input_stream target{ std::move(stream) };
+
+        CHECK( target.view().data() == junk.data() );
+        CHECK( target.position() == 3 );
+
+        CHECK( stream.view().data() == nullptr );
+        CHECK( stream.position() == 0 );
+        CHECK( stream.length() == 0 );
+    }
+
+    SECTION( "when reading primitives" )
+    {
+        CHECK( stream.read_numeric_or_fail<uint32_t, std::endian::little>() == 0x4030201 );
+        CHECK( stream.read_numeric_or_fail<uint8_t, std::endian::big>() == 12u );
+        CHECK( stream.read_numeric_or_fail<uint16_t, std::endian::big>() == 43105u );
+        CHECK( stream.read_numeric_or_fail<uint32_t, std::endian::big>() == 874606462u );
+        CHECK( stream.read_numeric_or_fail<uint64_t, std::endian::big>() == 5688944245090268673u );
+
+        CHECK( stream.position() == 19 );
+        CHECK( stream.read_byte() == -1 );
+        CHECK_THROWS( stream.read_numeric_or_fail<uint32_t, std::endian::big>() );
+
+        CHECK_THROWS_AS( stream.read_bytes(weak_buffer{ nullptr, 4u }), io_exception );
+    }
+
+    SECTION( "when lending views" )
+    {
+        stream.seek_begin(4);
+        const auto view = stream.try_read_view(3u);
+
+        REQUIRE( view.has_value() );
+        CHECK( view->data() == junk.data() + 4 );
+        CHECK( view->length() == 3u );
+        CHECK( stream.position() == 7 );
+    }
+
+    SECTION( "when seeking" )
+    {
+        stream.seek_begin(3);
+        CHECK( stream.position() == 3 );
+
+        stream.seek_current(10);
+        CHECK( stream.position() == 13 );
+
+        stream.seek_end(-5);
+        CHECK( stream.position() == 14 );
+
+        CHECK_THROWS_AS( stream.seek_begin(-1), io_exception );
+        CHECK_THROWS_AS( stream.seek_begin(19), io_exception );
+        CHECK_THROWS_AS( stream.seek_current(100), io_exception );
+        CHECK_THROWS_AS( stream.seek_end(1), io_exception );
+    }
+}
+
 
 
 
@@ -595,3 +721,105 @@ TEST_CASE( "memory output stream can be seeked", "[streams][memory_streams][outp
         CHECK_THROWS_AS( stream.seek_begin(-100), io_exception );
     }
 }
+
+
+TEST_CASE( "memory streams (de)serialize numeric arrays", "[streams][memory_streams][input_streams][output_streams]" )
+{
+    std::array<uint8_t, 16u> junk = {
+        0x01, 0x02, 0x03, 0x04,
+        0xA8, 0x61, 0x34, 0x21,
+        0x6F, 0x7E, 0x4E, 0xF3,
+        0x30, 0xA6, 0x4B, 0x9B
+    };
+
+    SECTION( "of numbers in little-endian" )
+    {
+        memory_input_stream stream{ weak_buffer{ junk.data(), junk.size() } };
+        std::array<uint32_t, 4u> values{};
+
+        CHECK( stream.read_numeric_array<uint32_t, std::endian::little>(values) );
+        CHECK( values == std::array<uint32_t, 4u>{ 0x04030201, 0x213461A8, 0xF34E7E6F, 0x9B4BA630 } );
+        CHECK( stream.position() == 16 );
+    }
+
+    SECTION( "of numbers in big-endian" )
+    {
+        memory_input_stream stream{ weak_buffer{ junk.data(), junk.size() } };
+        std::array<uint16_t, 8u> values{};
+
+        CHECK_NOTHROW( stream.read_numeric_array_or_fail<uint16_t, std::endian::big>(values) );
+        CHECK( values == std::array<uint16_t, 8u>{ 0x0102, 0x0304, 0xA861, 0x3421, 0x6F7E, 0x4EF3, 0x30A6, 0x4B9B } );
+
+        stream.seek_begin(4);
+        CHECK( !stream.read_numeric_array<uint16_t, std::endian::big>(values) );
+        CHECK_THROWS_AS( (stream.read_numeric_array_or_fail<uint16_t, std::endian::big>(values)), io_exception );
+
+        // empty arrays don't touch the stream at all
+        CHECK( stream.read_numeric_array<uint16_t, std::endian::big>(std::span<uint16_t>{}) );
+    }
+
+    SECTION( "back and forth in big-endian" )
+    {
+        std::array<uint64_t, 1000u> values{};
+        std::ranges::generate(values, [n = uint64_t{ 0x0102030405060708u }]() mutable { return n += 0x1111; });
+
+        memory_output_stream output{};
+        CHECK( output.write_numeric_array<uint64_t, std::endian::big>(values) );
+        CHECK( output.length() == 8000 );
+        CHECK( output.view()[0] == 0x01 );
+        CHECK( output.view()[7] == 0x19 );
+
+        memory_input_stream input{ weak_buffer{ output.view().data(), output.view().length() } };
+        std::array<uint64_t, 1000u> values_2{};
+
+        CHECK( input.read_numeric_array<uint64_t, std::endian::big>(values_2) );
+        CHECK( values == values_2 );
+    }
+
+    SECTION( "and report short writes" )
+    {
+        std::array<uint32_t, 4u> values{ 1u, 2u, 3u, 4u };
+        memory_output_stream stream{ 10u, growth_factor::none };
+
+        CHECK( !stream.write_numeric_array<uint32_t, std::endian::big>(values) );
+        CHECK_THROWS_AS( (stream.write_numeric_array_or_fail<uint32_t, std::endian::little>(values)), io_exception );
+    }
+}
+
+
+TEST_CASE( "memory streams transfer sequences of buffers", "[streams][memory_streams]" )
+{
+    std::array<byte, 10u> junk{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    std::array<weak_buffer, 4u> parts = {
+        weak_buffer{ junk.data(), 3u },
+        weak_buffer{ junk.data() + 3u, 0u },
+        weak_buffer{ junk.data() + 3u, 5u },
+        weak_buffer{ junk.data() + 8u, 2u }
+    };
+
+    SECTION( "gathered on output" )
+    {
+        memory_output_stream stream{};
+
+        CHECK( stream.write_bytes_gather(parts) == 10 );
+        CHECK( std::ranges::equal(stream.view(), junk) );
+
+        memory_output_stream fixed{ 6u, growth_factor::none };
+        CHECK( fixed.write_bytes_gather(parts) == 6 );
+    }
+
+    SECTION( "scattered on input" )
+    {
+        memory_input_stream stream{ weak_buffer{ junk.data(), 9u } };
+        std::array<byte, 10u> data{};
+        std::array<weak_buffer, 3u> outputs = {
+            weak_buffer{ data.data() + 5u, 5u },
+            weak_buffer{ data.data(), 0u },
+            weak_buffer{ data.data(), 5u }
+        };
+
+        CHECK( stream.read_bytes_scatter(outputs) == 9 );
+        CHECK( std::ranges::equal(data, std::array<byte, 10u>{ 5, 6, 7, 8, 0, 0, 1, 2, 3, 4 }) );
+        CHECK( stream.position() == 9 );
+    }
+}
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <array>
+
+#include "reio/streams/mmap_streams.hpp"
+#include "reio/streams/readers.hpp"
+using namespace reio;
+
+
+static constexpr auto k_mmap_small_path = REIO_TESTS_DATA_DIR "/small.bin";
+
+static_assert( consumable_source<mmap_input_stream> );
+
+
+TEST_CASE( "mmap input stream can be initialized", "[streams][mmap_streams][input_streams]" )
+{
+    SECTION( "from a file path" )
+    {
+        mmap_input_stream stream{ k_mmap_small_path };
+
+        CHECK( stream.position() == 0 );
+        CHECK( stream.length() == 19 );
+        CHECK( stream.view().data() != nullptr );
+        CHECK( stream.view().length() == 19u );
+    }
+
+    SECTION( "with mapping options" )
+    {
+        mmap_input_stream stream{ k_mmap_small_path, { .m_populate = true, .m_advice = mmap_advice::sequential } };
+
+        CHECK( stream.length() == 19 );
+        CHECK_NOTHROW( stream.advise(mmap_advice::willneed) );
+        CHECK_NOTHROW( stream.advise(mmap_advice::random, 4, 8) );
+        CHECK_THROWS_AS( stream.advise(mmap_advice::random, 4, 100), io_exception );
+    }
+
+    SECTION( "by move-constructor" )
+    {
+        mmap_input_stream origin{ k_mmap_small_path };
+        origin.seek_begin(3);
+
+        mmap_input_stream target{ std::move(origin) };
+
+        CHECK( target.position() == 3 );
+        CHECK( target.length() == 19 );
+
+        CHECK( origin.view().data() == nullptr );
+        CHECK( origin.position() == 0 );
+        CHECK( origin.length() == 0 );
+    }
+
+    SECTION( "but not from a missing file" )
+    {
+        CHECK_THROWS_AS( mmap_input_stream{ REIO_TESTS_DATA_DIR "/missing.bin" }, io_exception );
+    }
+}
+
+
+TEST_CASE( "mmap input stream deserializes primitives", "[streams][mmap_streams][input_streams]" )
+{
+    mmap_input_stream stream{ k_mmap_small_path };
+
+    SECTION( "of arbitrary buffers" )
+    {
+        std::array<byte, 100> data{};
+
+        CHECK( stream.read_bytes(weak_buffer{ data.data(), 4u }) == 4 );
+        CHECK( stream.read_bytes(weak_buffer{ data.data() + 4u, data.size() - 4u }) == 15 );
+        CHECK( std::equal(data.begin(), data.begin() + 19, stream.view().begin()) );
+        CHECK( stream.position() == 19 );
+        CHECK( stream.read_byte() == -1 );
+
+        CHECK_THROWS_AS( stream.read_bytes(weak_buffer{ nullptr, 4u }), io_exception );
+        CHECK_THROWS_AS( stream.read_bytes(weak_buffer{ data.data(), 0u }), io_exception );
+    }
+
+    SECTION( "of numbers in big-endian" )
+    {
+        stream.seek_begin(4);
+
+        CHECK( stream.read_numeric_or_fail<uint8_t, std::endian::big>() == 12u );
+        CHECK( stream.read_numeric_or_fail<uint16_t, std::endian::big>() == 43105u );
+        CHECK( stream.read_numeric_or_fail<uint32_t, std::endian::big>() == 874606462u );
+        CHECK( stream.read_numeric_or_fail<uint64_t, std::endian::big>() == 5688944245090268673u );
+
+        CHECK_THROWS( stream.read_numeric_or_fail<uint32_t, std::endian::big>() );
+    }
+
+    SECTION( "through a reader" )
+    {
+        basic_reader reader{ stream };
+        stream.seek_begin(4);
+
+        CHECK( reader.read_numeric_or_fail<uint8_t, std::endian::big>() == 12u );
+        CHECK( reader.read_numeric_or_fail<uint16_t, std::endian::big>() == 43105u );
+        CHECK( reader.read_numeric_or_fail<uint32_t, std::endian::big>() == 874606462u );
+        CHECK( reader.read_numeric_or_fail<uint64_t, std::endian::big>() == 5688944245090268673u );
+
+        CHECK_THROWS( reader.read_numeric_or_fail<uint32_t, std::endian::big>() );
+    }
+
+    SECTION( "of views without copying" )
+    {
+        const auto view = stream.view(4, 3);
+
+        CHECK( view.data() == stream.view().data() + 4 );
+        CHECK( std::ranges::equal(view, std::array<uint8_t, 3u>{ 0x0C, 0xA8, 0x61 }) );
+        CHECK( stream.position() == 0 );
+
+        const auto borrowed = stream.try_read_view(3u);
+
+        REQUIRE( borrowed.has_value() );
+        CHECK( borrowed->data() == stream.view().data() );
+        CHECK( borrowed->length() == 3u );
+        CHECK( stream.position() == 3 );
+
+        CHECK_NOTHROW( stream.view(19, 0) );
+        CHECK_THROWS_AS( stream.view(20, 0), io_exception );
+        CHECK_THROWS_AS( stream.view(4, 16), io_exception );
+    }
+
+    SECTION( "at arbitrary offsets" )
+    {
+        std::array<byte, 4u> data{};
+
+        CHECK( stream.size() == 19 );
+        CHECK( stream.read_at(17, weak_buffer{ data.data(), data.size() }) == 2 );
+        CHECK( data[1] == 0x01 );
+        CHECK( stream.view_at(4, 3u)->data() == stream.view().data() + 4 );
+        CHECK( stream.view_at(17, 4u)->length() == 2u );
+        CHECK( stream.position() == 0 );
+    }
+}
+
+
+TEST_CASE( "mmap input stream can be seeked", "[streams][mmap_streams][input_streams]" )
+{
+    mmap_input_stream stream{ k_mmap_small_path };
+
+    stream.seek_begin(3);
+    CHECK( stream.position() == 3 );
+
+    stream.seek_current(10);
+    CHECK( stream.position() == 13 );
+
+    stream.seek_end(-5);
+    CHECK( stream.position() == 14 );
+
+    CHECK_THROWS_AS( stream.seek_begin(-1), io_exception );
+    CHECK_THROWS_AS( stream.seek_current(100), io_exception );
+    CHECK_THROWS_AS( stream.seek_end(1), io_exception );
+}
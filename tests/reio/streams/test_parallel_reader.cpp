@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "reio/streams/memory_streams.hpp"
+#include "reio/streams/parallel_reader.hpp"
+using namespace reio;
+
+
+///
+/// Source without views, so the reader has to copy chunks into worker buffers.
+///
+class parallel_copy_source final : public random_access_source
+{
+private:
+
+    const std::vector<byte>* m_data;
+
+public:
+
+    explicit parallel_copy_source(const std::vector<byte>* data) : m_data{ data } {}
+
+    int64_t size() const override
+    {
+        return static_cast<int64_t>(m_data->size());
+    }
+
+    int64_t read_at(int64_t offset, weak_buffer output) const override
+    {
+        // deliberately short reads, to exercise retries
+        const auto available = std::max<int64_t>(size() - offset, 0);
+        const auto count = std::min<int64_t>({ available, static_cast<int64_t>(output.length()), 7 });
+        std::copy_n(m_data->begin() + offset, count, output.data());
+        return count;
+    }
+};
+
+
+static std::vector<byte> DoMakeParallelJunk(std::size_t size)
+{
+    std::vector<byte> junk(size);
+    for (std::size_t i = 0u; i < size; i++)
+    {
+        junk[i] = static_cast<byte>(i * 31u);
+    }
+    return junk;
+}
+
+
+TEST_CASE( "parallel reader reads sources in chunks", "[streams][parallel_reader]" )
+{
+    const auto junk = DoMakeParallelJunk(1000u);
+
+    view_input_stream viewed{ weak_buffer{ const_cast<byte*>(junk.data()), junk.size() } };
+    parallel_copy_source copied{ &junk };
+
+    const random_access_source* source = GENERATE_REF( as<const random_access_source*>{}, &viewed, &copied );
+    parallel_reader reader{ source, { .m_chunk_size = 64u, .m_concurrency = 4u } };
+
+    CHECK( reader.source() == source );
+    CHECK( reader.concurrency() == 4u );
+
+    SECTION( "of the whole source" )
+    {
+        std::vector<byte> result(junk.size());
+        std::vector<std::pair<int64_t, std::size_t>> chunks;
+        std::mutex mutex;
+
+        // Catch assertions aren't thread-safe, so chunks are only checked afterwards
+        const auto read = reader.read_all([&](int64_t offset, weak_buffer chunk) {
+            std::copy(chunk.begin(), chunk.end(), result.begin() + offset);
+
+            std::lock_guard lock{ mutex };
+            chunks.emplace_back(offset, chunk.length());
+        });
+
+        std::ranges::sort(chunks);
+
+        CHECK( read == 1000 );
+        CHECK( result == junk );
+        REQUIRE( chunks.size() == 16u );
+        CHECK( chunks.front() == std::pair<int64_t, std::size_t>{ 0, 64u } );
+        CHECK( chunks.back() == std::pair<int64_t, std::size_t>{ 960, 40u } );
+    }
+
+    SECTION( "of a clamped range, reusing workers" )
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            std::atomic<int64_t> sum = 0;
+            const auto read = reader.read(900, 500, [&](int64_t, weak_buffer chunk) {
+                sum += std::accumulate(chunk.begin(), chunk.end(), int64_t{ 0 });
+            });
+
+            CHECK( read == 100 );
+            CHECK( sum == std::accumulate(junk.begin() + 900, junk.end(), int64_t{ 0 }) );
+        }
+
+        // sizes meaning "to the end" are clamped without overflowing
+        CHECK( reader.read(900, INT64_MAX, [](int64_t, weak_buffer) {}) == 100 );
+
+        CHECK( reader.read(1000, 10, [](int64_t, weak_buffer) {}) == 0 );
+        CHECK_THROWS_AS( reader.read(-1, 10, [](int64_t, weak_buffer) {}), io_exception );
+    }
+
+    SECTION( "and rethrows callback failures" )
+    {
+        const auto fail = [](int64_t offset, weak_buffer) {
+            if (offset == 320)
+            {
+                throw std::runtime_error{ "callback failed" };
+            }
+        };
+
+        CHECK_THROWS_AS( reader.read_all(fail), std::runtime_error );
+        CHECK( reader.read_all([](int64_t, weak_buffer) {}) == 1000 );
+    }
+}
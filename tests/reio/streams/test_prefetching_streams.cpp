@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "reio/streams/memory_streams.hpp"
+#include "reio/streams/prefetching_streams.hpp"
+#include "reio/streams/readers.hpp"
+using namespace reio;
+
+
+static_assert( consumable_source<prefetching_input_stream> );
+
+
+///
+/// Pass-through input stream which fails once when a read reaches a certain position.
+///
+class failing_input_stream final : public input_stream
+{
+public:
+
+    input_stream*   m_inner;
+    int64_t         m_fail_at;
+
+    failing_input_stream(input_stream* inner, int64_t fail_at) : m_inner{ inner }, m_fail_at{ fail_at } {}
+
+    int64_t position() override { return m_inner->position(); }
+    int64_t length() override { return m_inner->length(); }
+    void seek_begin(int64_t offset) override { m_inner->seek_begin(offset); }
+    void seek_current(int64_t offset) override { m_inner->seek_current(offset); }
+    void seek_end(int64_t offset) override { m_inner->seek_end(offset); }
+
+    int64_t read_bytes(weak_buffer output) override
+    {
+        if (m_inner->position() >= m_fail_at)
+        {
+            m_fail_at = INT64_MAX;
+            throw std::runtime_error{ "read failed" };
+        }
+        return m_inner->read_bytes(output);
+    }
+};
+
+
+static std::vector<byte> DoMakePrefetchJunk(std::size_t size)
+{
+    std::vector<byte> junk(size);
+    std::iota(junk.begin(), junk.end(), byte{ 0u });
+    return junk;
+}
+
+
+TEST_CASE( "prefetching input stream can be initialized", "[streams][prefetching_streams][input_streams]" )
+{
+    auto junk = DoMakePrefetchJunk(100u);
+    memory_input_stream inner{ weak_buffer{ junk.data(), junk.size() } };
+
+    SECTION( "with default slots" )
+    {
+        prefetching_input_stream stream{ &inner };
+
+        CHECK( stream.source() == &inner );
+        CHECK( stream.slot_size() == k_default_prefetch_slot_size );
+        CHECK( stream.slot_count() == k_default_prefetch_slot_count );
+        CHECK( stream.position() == 0 );
+        CHECK( stream.length() == 100 );
+    }
+
+    SECTION( "at the current position of the wrapped stream" )
+    {
+        inner.seek_begin(5);
+
+        prefetching_input_stream stream{ &inner, 8u, 2u };
+        CHECK( stream.position() == 5 );
+        CHECK( stream.read_byte() == 5 );
+    }
+
+    SECTION( "but not with invalid arguments" )
+    {
+        CHECK_THROWS_AS( prefetching_input_stream( nullptr ), io_exception );
+        CHECK_THROWS_AS( prefetching_input_stream( &inner, 0u ), io_exception );
+        CHECK_THROWS_AS( prefetching_input_stream( &inner, 8u, 1u ), io_exception );
+    }
+}
+
+
+TEST_CASE( "prefetching input stream reads ahead", "[streams][prefetching_streams][input_streams]" )
+{
+    auto junk = DoMakePrefetchJunk(250u);
+    memory_input_stream inner{ weak_buffer{ junk.data(), junk.size() } };
+    prefetching_input_stream stream{ &inner, 16u, 3u };
+
+    SECTION( "across slots" )
+    {
+        std::vector<byte> result(300u);
+
+        CHECK( stream.read_bytes(weak_buffer{ result.data(), 5u }) == 5 );
+        CHECK( stream.read_byte() == 5 );
+        CHECK( stream.read_bytes(weak_buffer{ result.data() + 6u, 100u }) == 100 );
+        CHECK( stream.read_bytes(weak_buffer{ result.data() + 106u, 194u }) == 144 );
+        CHECK( std::equal(junk.begin() + 6, junk.end(), result.begin() + 6) );
+
+        CHECK( stream.position() == 250 );
+        CHECK( stream.read_byte() == -1 );
+    }
+
+    SECTION( "through a reader" )
+    {
+        basic_reader reader{ stream };
+
+        CHECK( reader.read_numeric_or_fail<uint16_t, std::endian::big>() == 0x0001u );
+        CHECK( reader.read_numeric_or_fail<uint32_t, std::endian::big>() == 0x02030405u );
+
+        // crosses a slot boundary
+        stream.seek_begin(14);
+        CHECK( reader.read_numeric_or_fail<uint32_t, std::endian::big>() == 0x0E0F1011u );
+        CHECK( stream.position() == 18 );
+    }
+}
+
+
+TEST_CASE( "prefetching input stream can be seeked", "[streams][prefetching_streams][input_streams]" )
+{
+    auto junk = DoMakePrefetchJunk(250u);
+    memory_input_stream inner{ weak_buffer{ junk.data(), junk.size() } };
+    prefetching_input_stream stream{ &inner, 16u, 3u };
+
+    CHECK( stream.read_byte() == 0 );
+
+    // within the current slot
+    stream.seek_current(10);
+    CHECK( stream.position() == 11 );
+    CHECK( stream.read_byte() == 11 );
+
+    // far ahead, dropping prefetched slots
+    stream.seek_begin(200);
+    CHECK( stream.read_byte() == 200 );
+
+    // backwards
+    stream.seek_current(-150);
+    CHECK( stream.position() == 51 );
+    CHECK( stream.read_byte() == 51 );
+
+    stream.seek_end(-1);
+    CHECK( stream.position() == 249 );
+    CHECK( stream.read_byte() == 249 );
+    CHECK( stream.read_byte() == -1 );
+
+    // failed seeks keep the stream usable
+    stream.seek_begin(3);
+    CHECK_THROWS_AS( stream.seek_begin(-1), io_exception );
+    CHECK_THROWS_AS( stream.seek_current(1000), io_exception );
+    CHECK( stream.position() == 3 );
+    CHECK( stream.read_byte() == 3 );
+}
+
+
+TEST_CASE( "prefetching input stream reports failures of the wrapped stream", "[streams][prefetching_streams][input_streams]" )
+{
+    auto junk = DoMakePrefetchJunk(100u);
+    memory_input_stream inner{ weak_buffer{ junk.data(), junk.size() } };
+    failing_input_stream failing{ &inner, 32 };
+    prefetching_input_stream stream{ &failing, 16u, 2u };
+
+    std::vector<byte> result(100u);
+
+    CHECK( stream.read_bytes(weak_buffer{ result.data(), 32u }) == 32 );
+    CHECK_THROWS_AS( stream.read_byte(), std::runtime_error );
+
+    // reported once, then reading goes on
+    CHECK( stream.read_bytes(weak_buffer{ result.data() + 32u, 68u }) == 68 );
+    CHECK( result == junk );
+}
+
+
+TEST_CASE( "prefetching input stream keeps bytes read before a failure", "[streams][prefetching_streams][input_streams]" )
+{
+    auto junk = DoMakePrefetchJunk(100u);
+    memory_input_stream inner{ weak_buffer{ junk.data(), junk.size() } };
+    failing_input_stream failing{ &inner, 32 };
+    prefetching_input_stream stream{ &failing, 16u, 2u };
+
+    std::vector<byte> result(100u);
+
+    // the read crosses the failure, so it stops short and leaves the failure for the next one
+    CHECK( stream.read_bytes(weak_buffer{ result.data(), 50u }) == 32 );
+    CHECK( stream.position() == 32 );
+    CHECK_THROWS_AS( stream.read_bytes(weak_buffer{ result.data() + 32u, 68u }), std::runtime_error );
+
+    CHECK( stream.read_bytes(weak_buffer{ result.data() + 32u, 68u }) == 68 );
+    CHECK( result == junk );
+}
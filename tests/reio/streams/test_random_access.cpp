@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "reio/streams/memory_streams.hpp"
+#include "reio/streams/random_access.hpp"
+using namespace reio;
+
+
+TEMPLATE_TEST_CASE( "memory sources read at arbitrary offsets", "[streams][random_access]",
+                    memory_input_stream, view_input_stream )
+{
+    std::array<uint8_t, 8u> junk = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+
+    TestType stream{ weak_buffer{ junk.data(), junk.size() } };
+    const random_access_source& source = stream;
+
+    SECTION( "by copying" )
+    {
+        std::array<byte, 4u> data{};
+
+        CHECK( source.size() == 8 );
+        CHECK( source.read_at(2, weak_buffer{ data.data(), data.size() }) == 4 );
+        CHECK( std::ranges::equal(data, std::array<uint8_t, 4u>{ 0x02, 0x03, 0x04, 0x05 }) );
+        CHECK( source.read_at(6, weak_buffer{ data.data(), data.size() }) == 2 );
+        CHECK( source.read_at(8, weak_buffer{ data.data(), data.size() }) == 0 );
+        CHECK( source.read_at(100, weak_buffer{ data.data(), data.size() }) == 0 );
+
+        // the stream's own cursor is not shared
+        CHECK( stream.position() == 0 );
+
+        CHECK_THROWS_AS( source.read_at(-1, weak_buffer{ data.data(), data.size() }), io_exception );
+        CHECK_THROWS_AS( source.read_at(0, weak_buffer{ nullptr, 4u }), io_exception );
+        CHECK_THROWS_AS( source.read_at(0, weak_buffer{ data.data(), 0u }), io_exception );
+    }
+
+    SECTION( "by borrowing views" )
+    {
+        const auto view = source.view_at(5, 10u);
+
+        REQUIRE( view.has_value() );
+        CHECK( view->data() == stream.view().data() + 5 );
+        CHECK( view->length() == 3u );
+
+        CHECK( source.view_at(8, 1u)->length() == 0u );
+        CHECK_THROWS_AS( source.view_at(-1, 1u), io_exception );
+    }
+}
+
+
+TEST_CASE( "cursor input stream reads a source sequentially", "[streams][random_access][input_streams]" )
+{
+    std::array<uint8_t, 8u> junk = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+    view_input_stream source{ weak_buffer{ junk.data(), junk.size() } };
+
+    SECTION( "with its own position" )
+    {
+        cursor_input_stream first{ &source };
+        cursor_input_stream second{ &source, 4 };
+
+        CHECK( first.source() == &source );
+        CHECK( first.length() == 8 );
+        CHECK( second.position() == 4 );
+
+        CHECK( first.read_numeric_or_fail<uint16_t, std::endian::big>() == 0x0001u );
+        CHECK( second.read_numeric_or_fail<uint16_t, std::endian::big>() == 0x0405u );
+        CHECK( first.position() == 2 );
+        CHECK( second.position() == 6 );
+        CHECK( source.position() == 0 );
+
+        second.seek_end(-1);
+        CHECK( second.read_byte() == 0x07 );
+        CHECK( second.read_byte() == -1 );
+
+        CHECK_THROWS_AS( first.seek_begin(8), io_exception );
+        CHECK_THROWS_AS( (cursor_input_stream{ &source, 9 }), io_exception );
+        CHECK_THROWS_AS( (cursor_input_stream{ nullptr }), io_exception );
+    }
+
+    SECTION( "with views borrowed from the source" )
+    {
+        cursor_input_stream cursor{ &source, 2 };
+        const auto view = cursor.try_read_view(3u);
+
+        REQUIRE( view.has_value() );
+        CHECK( view->data() == source.view().data() + 2 );
+        CHECK( cursor.position() == 5 );
+    }
+
+    SECTION( "from several threads at once" )
+    {
+        std::vector<uint32_t> sums(4u, 0u);
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 0u; i < sums.size(); i++)
+        {
+            threads.emplace_back([&source, &sums, i]() {
+                cursor_input_stream cursor{ &source, static_cast<int64_t>(i) };
+                for (int64_t value; (value = cursor.read_byte()) >= 0; )
+                {
+                    sums[i] += static_cast<uint32_t>(value);
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        CHECK( sums == std::vector<uint32_t>{ 28u, 28u, 27u, 25u } );
+    }
+}
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <array>
+
+#include "reio/streams/buffered_streams.hpp"
+#include "reio/streams/memory_streams.hpp"
+#include "reio/streams/readers.hpp"
+using namespace reio;
+
+
+static_assert( consumable_source<memory_input_stream> );
+static_assert( consumable_source<view_input_stream> );
+static_assert( consumable_source<buffered_input_stream> );
+static_assert( !consumable_source<input_stream> );
+
+
+TEMPLATE_TEST_CASE( "reader deserializes primitives", "[streams][readers]",
+                    memory_input_stream, view_input_stream )
+{
+    std::array<uint8_t, 19u> junk = {
+        0x01, 0x02, 0x03, 0x04,
+        0x0C,
+        0xA8, 0x61,
+        0x34, 0x21, 0x6F, 0x7E,
+        0x4E, 0xF3, 0x30, 0xA6, 0x4B, 0x9B, 0xB6, 0x01
+    };
+
+    TestType stream{ weak_buffer{ junk.data(), junk.size() } };
+    basic_reader reader{ stream };
+
+    SECTION( "of arbitrary buffers" )
+    {
+        std::array<byte, 4u> data{};
+
+        CHECK( reader.read_bytes(weak_buffer{ data.data(), data.size() }) == 4 );
+        CHECK( std::ranges::equal(data, std::array<uint8_t, 4u>{ 0x01, 0x02, 0x03, 0x04 }) );
+        CHECK( stream.position() == 4 );
+
+        std::array<byte, 100u> data_2{};
+
+        CHECK( reader.read_bytes(weak_buffer{ data_2.data(), data_2.size() }) == 15 );
+        CHECK_THROWS_AS( reader.read_bytes_or_fail(weak_buffer{ data_2.data(), data_2.size() }), io_exception );
+        CHECK_THROWS_AS( reader.read_bytes(weak_buffer{ nullptr, 4u }), io_exception );
+        CHECK_THROWS_AS( reader.read_bytes(weak_buffer{ data_2.data(), 0u }), io_exception );
+    }
+
+    SECTION( "of single bytes" )
+    {
+        CHECK( reader.read_byte() == 1 );
+        CHECK( reader.read_byte() == 2 );
+
+        stream.seek_end(0);
+        CHECK( reader.read_byte() == -1 );
+    }
+
+    SECTION( "of numbers in little-endian" )
+    {
+        stream.seek_begin(4);
+
+        CHECK( reader.template read_numeric_or_fail<uint8_t, std::endian::little>() == 12u );
+        CHECK( reader.template read_numeric_or_fail<uint16_t, std::endian::little>() == 25000u );
+        CHECK( reader.template read_numeric_or_fail<uint32_t, std::endian::little>() == 2121212212u );
+        CHECK( reader.template read_numeric_or_fail<uint64_t, std::endian::little>() == 123456789012345678u );
+
+        CHECK( stream.position() == 19 );
+
+        uint32_t num_junk;
+        CHECK( !reader.template read_numeric<uint32_t, std::endian::little>(num_junk) );
+    }
+
+    SECTION( "of numbers in big-endian" )
+    {
+        stream.seek_begin(4);
+
+        CHECK( reader.template read_numeric_or_fail<uint8_t, std::endian::big>() == 12u );
+        CHECK( reader.template read_numeric_or_fail<uint16_t, std::endian::big>() == 43105u );
+        CHECK( reader.template read_numeric_or_fail<uint32_t, std::endian::big>() == 874606462u );
+        CHECK( reader.template read_numeric_or_fail<uint64_t, std::endian::big>() == 5688944245090268673u );
+
+        CHECK_THROWS( reader.template read_numeric_or_fail<uint32_t, std::endian::big>() );
+    }
+}
+
+
+TEST_CASE( "reader falls back to the stream when its storage runs out", "[streams][readers]" )
+{
+    std::array<uint8_t, 8u> junk = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+
+    memory_input_stream inner{ weak_buffer{ junk.data(), junk.size() } };
+    buffered_input_stream stream{ &inner, 3u };
+    basic_reader reader{ stream };
+
+    // every number crosses a window boundary at some point
+    CHECK( reader.read_numeric_or_fail<uint16_t, std::endian::big>() == 0x0001 );
+    CHECK( reader.read_numeric_or_fail<uint16_t, std::endian::big>() == 0x0203 );
+    CHECK( reader.read_numeric_or_fail<uint32_t, std::endian::big>() == 0x04050607 );
+    CHECK( reader.read_byte() == -1 );
+    CHECK( stream.position() == 8 );
+}
+
+
+TEST_CASE( "type-erased reader works with any stream", "[streams][readers]" )
+{
+    std::array<uint8_t, 4u> junk = { 0x01, 0x02, 0x03, 0x04 };
+
+    memory_input_stream stream{ weak_buffer{ junk.data(), junk.size() } };
+    reader reader_{ stream };
+
+    CHECK( &reader_.source() == &stream );
+    CHECK( reader_.read_numeric_or_fail<uint16_t, std::endian::big>() == 0x0102 );
+    CHECK( reader_.read_byte() == 3 );
+    CHECK( stream.position() == 3 );
+}
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+#include "reio/allocators.hpp"
+#include "reio/streams/segmented_streams.hpp"
+using namespace reio;
+
+
+TEST_CASE( "segmented output stream can be initialized", "[streams][segmented_streams][output_streams]" )
+{
+    SECTION( "empty, without any segments" )
+    {
+        segmented_output_stream stream{ 8u };
+
+        CHECK( stream.segment_size() == 8u );
+        CHECK( stream.segment_count() == 0u );
+        CHECK( stream.segments().empty() );
+        CHECK( stream.position() == 0 );
+        CHECK( stream.length() == 0 );
+        CHECK( stream.flatten().length() == 0u );
+    }
+
+    SECTION( "by move-constructor" )
+    {
+        std::array<byte, 10u> junk{};
+
+        segmented_output_stream origin{ 8u };
+        origin.write_bytes(weak_buffer{ junk.data(), junk.size() });
+
+        segmented_output_stream target{ std::move(origin) };
+
+        CHECK( target.length() == 10 );
+        CHECK( target.segment_count() == 2u );
+        CHECK( origin.length() == 0 );
+        CHECK( origin.segment_count() == 0u );
+    }
+
+    SECTION( "but not with invalid parameters" )
+    {
+        CHECK_THROWS_AS( segmented_output_stream( 0u ), io_exception );
+        CHECK_THROWS_AS( segmented_output_stream( 8u, nullptr ), io_exception );
+    }
+}
+
+
+TEST_CASE( "segmented output stream writes across segments", "[streams][segmented_streams][output_streams]" )
+{
+    std::array<byte, 20u> junk{};
+    std::iota(junk.begin(), junk.end(), byte{ 1u });
+
+    arena_allocator arena{ 256u };
+    segmented_output_stream stream{ 8u, &arena };
+
+    SECTION( "without moving earlier segments" )
+    {
+        stream.write_bytes(weak_buffer{ junk.data(), 5u });
+        const auto first = stream.segments().front().data();
+
+        stream.write_bytes(weak_buffer{ junk.data() + 5u, 15u });
+
+        CHECK( stream.length() == 20 );
+        CHECK( stream.position() == 20 );
+        CHECK( stream.segment_count() == 3u );
+
+        const auto segments = stream.segments();
+        REQUIRE( segments.size() == 3u );
+        CHECK( segments[0].data() == first );
+        CHECK( segments[0].length() == 8u );
+        CHECK( segments[1].length() == 8u );
+        CHECK( segments[2].length() == 4u );
+        CHECK( segments[2][3] == 20 );
+
+        const auto flat = stream.flatten();
+        CHECK( std::ranges::equal(flat, junk) );
+    }
+
+    SECTION( "with overwrites after seeking" )
+    {
+        stream.write_bytes(weak_buffer{ junk.data(), junk.size() });
+
+        std::array<byte, 6u> patch = { 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5 };
+
+        stream.seek_begin(5);
+        CHECK( stream.write_bytes(weak_buffer{ patch.data(), patch.size() }) == 6 );
+        CHECK( stream.position() == 11 );
+        CHECK( stream.length() == 20 );
+
+        stream.seek_end(-2);
+        stream.write_bytes(weak_buffer{ patch.data(), patch.size() });
+        CHECK( stream.length() == 24 );
+
+        const auto flat = stream.flatten();
+        REQUIRE( flat.length() == 24u );
+        CHECK( flat[4] == 5 );
+        CHECK( flat[5] == 0xA0 );
+        CHECK( flat[10] == 0xA5 );
+        CHECK( flat[11] == 12 );
+        CHECK( flat[17] == 18 );
+        CHECK( flat[18] == 0xA0 );
+        CHECK( flat[23] == 0xA5 );
+
+        CHECK_THROWS_AS( stream.seek_begin(24), io_exception );
+        CHECK_THROWS_AS( stream.seek_current(1), io_exception );
+    }
+
+    SECTION( "with numbers crossing segment boundaries" )
+    {
+        stream.write_bytes(weak_buffer{ junk.data(), 6u });
+        stream.write_numeric<uint32_t, std::endian::big>(0x01020304u);
+
+        const auto flat = stream.flatten();
+        CHECK( flat[6] == 1 );
+        CHECK( flat[7] == 2 );
+        CHECK( flat[8] == 3 );
+        CHECK( flat[9] == 4 );
+    }
+
+    SECTION( "and frees segments on clear" )
+    {
+        stream.write_bytes(weak_buffer{ junk.data(), junk.size() });
+        stream.clear();
+
+        CHECK( stream.length() == 0 );
+        CHECK( stream.segment_count() == 0u );
+    }
+}
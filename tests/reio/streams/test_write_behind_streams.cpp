@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+#include "reio/streams/memory_streams.hpp"
+#include "reio/streams/write_behind_streams.hpp"
+using namespace reio;
+
+
+///
+/// Pass-through output stream which fails once when a write reaches a certain position.
+///
+class failing_output_stream final : public output_stream
+{
+public:
+
+    output_stream*  m_inner;
+    int64_t         m_fail_at;
+
+    failing_output_stream(output_stream* inner, int64_t fail_at) : m_inner{ inner }, m_fail_at{ fail_at } {}
+
+    int64_t position() override { return m_inner->position(); }
+    int64_t length() override { return m_inner->length(); }
+    void seek_begin(int64_t offset) override { m_inner->seek_begin(offset); }
+    void seek_current(int64_t offset) override { m_inner->seek_current(offset); }
+    void seek_end(int64_t offset) override { m_inner->seek_end(offset); }
+
+    int64_t write_bytes(weak_buffer input) override
+    {
+        if (m_inner->position() >= m_fail_at)
+        {
+            m_fail_at = INT64_MAX;
+            throw std::runtime_error{ "write failed" };
+        }
+        return m_inner->write_bytes(input);
+    }
+};
+
+
+TEST_CASE( "write-behind output stream can be initialized", "[streams][write_behind_streams][output_streams]" )
+{
+    memory_output_stream inner{};
+
+    SECTION( "with default slots" )
+    {
+        write_behind_output_stream stream{ &inner };
+
+        CHECK( stream.sink() == &inner );
+        CHECK( stream.slot_size() == k_default_write_behind_slot_size );
+        CHECK( stream.slot_count() == k_default_write_behind_slot_count );
+        CHECK( stream.position() == 0 );
+        CHECK( stream.length() == 0 );
+    }
+
+    SECTION( "but not with invalid arguments" )
+    {
+        CHECK_THROWS_AS( write_behind_output_stream( nullptr ), io_exception );
+        CHECK_THROWS_AS( write_behind_output_stream( &inner, 0u ), io_exception );
+        CHECK_THROWS_AS( write_behind_output_stream( &inner, 8u, 1u ), io_exception );
+    }
+}
+
+
+TEST_CASE( "write-behind output stream writes in the background", "[streams][write_behind_streams][output_streams]" )
+{
+    memory_output_stream inner{};
+    std::vector<byte> expected(1000u);
+
+    for (std::size_t i = 0u; i < expected.size(); i++)
+    {
+        expected[i] = static_cast<byte>(i * 7u);
+    }
+
+    SECTION( "until flushed" )
+    {
+        write_behind_output_stream stream{ &inner, 16u, 3u };
+
+        CHECK( stream.write_bytes(weak_buffer{ expected.data(), 500u }) == 500 );
+        for (std::size_t i = 500u; i < expected.size(); i++)
+        {
+            stream.write_byte(expected[i]);
+        }
+        CHECK( stream.position() == 1000 );
+
+        stream.flush();
+
+        CHECK( inner.position() == 1000 );
+        CHECK( std::ranges::equal(inner.view(), expected) );
+    }
+
+    SECTION( "until destroyed" )
+    {
+        {
+            write_behind_output_stream stream{ &inner, 64u, 2u };
+            stream.write_bytes(weak_buffer{ expected.data(), expected.size() });
+        }
+
+        CHECK( std::ranges::equal(inner.view(), expected) );
+    }
+}
+
+
+TEST_CASE( "write-behind output stream can be seeked", "[streams][write_behind_streams][output_streams]" )
+{
+    memory_output_stream inner{};
+    write_behind_output_stream stream{ &inner, 8u, 2u };
+
+    // placeholder for a header which is patched once the payload is written
+    stream.write_numeric_or_fail<uint32_t, std::endian::big>(0u);
+    for (auto i = 0u; i < 5u; i++)
+    {
+        stream.write_numeric_or_fail<uint32_t, std::endian::big>(i);
+    }
+
+    // within the current slot
+    stream.seek_current(-2);
+    stream.write_byte(0xEE);
+    stream.seek_current(1);
+    CHECK( stream.position() == 24 );
+
+    // outside of it, through the wrapped stream
+    stream.seek_begin(0);
+    stream.write_numeric_or_fail<uint32_t, std::endian::big>(0xAABBCCDDu);
+    CHECK( stream.length() == 24 );
+
+    stream.seek_end(0);
+    stream.write_byte(0xFF);
+    stream.flush();
+
+    CHECK( std::ranges::equal(inner.view(), std::array<uint8_t, 25u>{
+        0xAA, 0xBB, 0xCC, 0xDD,  0x00, 0x00, 0x00, 0x00,  0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x02,  0x00, 0x00, 0x00, 0x03,  0x00, 0x00, 0xEE, 0x04,
+        0xFF
+    }) );
+}
+
+
+TEST_CASE( "write-behind output stream reports failures of the wrapped stream", "[streams][write_behind_streams][output_streams]" )
+{
+    memory_output_stream inner{};
+    failing_output_stream failing{ &inner, 16 };
+    write_behind_output_stream stream{ &failing, 8u, 2u };
+
+    std::array<byte, 28u> junk{};
+
+    SECTION( "on flush" )
+    {
+        stream.write_bytes(weak_buffer{ junk.data(), junk.size() });
+        CHECK_THROWS_AS( stream.flush(), std::runtime_error );
+
+        // reported once
+        CHECK_NOTHROW( stream.flush() );
+        CHECK( inner.position() == 16 );
+    }
+
+    SECTION( "on the next call" )
+    {
+        stream.write_bytes(weak_buffer{ junk.data(), junk.size() });
+        CHECK_THROWS_AS( (void) stream.length(), std::runtime_error );
+        CHECK( stream.write_byte(0x01) );
+    }
+}
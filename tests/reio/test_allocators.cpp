@@ -0,0 +1,446 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "reio/allocators.hpp"
+#include "reio/buffers/owning_buffer.hpp"
+#include "reio/streams/memory_streams.hpp"
+using namespace reio;
+
+
+TEST_CASE( "arena allocator carves allocations from chunks", "[allocators][arena_allocator]" )
+{
+    arena_allocator arena{ 256u };
+
+    CHECK( arena.chunk_size() == 256u );
+    CHECK( arena.stats().m_chunk_count == 0u );
+
+    SECTION( "with aligned bump allocations" )
+    {
+        const auto a = arena.allocate(10u);
+        const auto b = arena.allocate(1u);
+
+        CHECK( reinterpret_cast<std::uintptr_t>(a) % alignof(std::max_align_t) == 0u );
+        CHECK( reinterpret_cast<std::uintptr_t>(b) % alignof(std::max_align_t) == 0u );
+        CHECK( b > a );
+        CHECK( b - a < 256 );
+
+        const auto stats = arena.stats();
+        CHECK( stats.m_chunk_count == 1u );
+        CHECK( stats.m_bytes_reserved == 256u );
+        CHECK( stats.m_allocation_count == 2u );
+        CHECK( stats.m_bytes_allocated >= 11u );
+    }
+
+    SECTION( "with new chunks when the current one is full" )
+    {
+        for (int i = 0; i < 20; i++)
+        {
+            std::memset(arena.allocate(64u), i, 64u);
+        }
+
+        CHECK( arena.stats().m_chunk_count == 5u );
+        CHECK( arena.stats().m_bytes_reserved == 5u * 256u );
+        CHECK( arena.stats().m_bytes_allocated == 20u * 64u );
+    }
+
+    SECTION( "with dedicated chunks for big requests" )
+    {
+        const auto small = arena.allocate(16u);
+        const auto big = arena.allocate(1000u);
+        const auto small_2 = arena.allocate(16u);
+
+        std::memset(big, 0xAB, 1000u);
+
+        CHECK( arena.stats().m_chunk_count == 2u );
+        CHECK( arena.stats().m_bytes_reserved >= 256u + 1000u );
+
+        // bumping continues within the regular chunk
+        CHECK( small_2 > small );
+        CHECK( small_2 - small < 256 );
+    }
+
+    SECTION( "with rollback of the last allocation only" )
+    {
+        const auto a = arena.allocate(32u);
+        const auto b = arena.allocate(32u);
+
+        arena.deallocate(a, 32u);
+        CHECK( arena.allocate(32u) > b );
+
+        const auto c = arena.allocate(32u);
+        arena.deallocate(c, 32u);
+        CHECK( arena.allocate(32u) == c );
+    }
+}
+
+
+TEST_CASE( "arena allocator resizes the last allocation in place", "[allocators][arena_allocator]" )
+{
+    arena_allocator arena{ 256u };
+
+    const auto a = arena.allocate(32u);
+    std::memset(a, 0xAB, 32u);
+
+    CHECK( arena.try_expand(a, 32u, 128u) );
+    CHECK( arena.try_expand(a, 128u, 64u) );
+    CHECK( arena.stats().m_bytes_allocated == 64u );
+    CHECK( !arena.try_expand(a, 64u, 1000u) );
+
+    const auto b = arena.allocate(16u);
+    CHECK( b == a + 64 );
+    CHECK( !arena.try_expand(a, 64u, 128u) );
+
+    // reallocation of an older block has to move it
+    const auto moved = arena.reallocate(a, 64u, 128u, 32u);
+    CHECK( moved != a );
+    CHECK( moved[31] == 0xAB );
+    CHECK( arena.reallocate(moved, 128u, 160u, 128u) == moved );
+
+    // over-aligned blocks are padded, and the padding is rolled back along with them
+    arena_allocator padded{ 256u };
+    auto front = padded.allocate(16u);
+    if (reinterpret_cast<std::uintptr_t>(front + 16) % 64u == 0u)
+    {
+        front = padded.allocate(16u);
+    }
+
+    const auto before = padded.stats().m_bytes_allocated;
+    const auto aligned = padded.allocate(32u, 64u);
+    CHECK( reinterpret_cast<std::uintptr_t>(aligned) % 64u == 0u );
+    CHECK( padded.stats().m_bytes_allocated > before + 32u );
+
+    CHECK( padded.try_expand(aligned, 32u, 48u, 64u) );
+    padded.deallocate(aligned, 48u, 64u);
+    CHECK( padded.stats().m_bytes_allocated == before );
+    CHECK( padded.allocate(16u) == front + 16 );
+}
+
+
+TEST_CASE( "arena allocator frees everything at once", "[allocators][arena_allocator]" )
+{
+    arena_allocator arena{ 128u };
+
+    arena.allocate(100u);
+    arena.allocate(100u);
+    arena.allocate(1000u);
+
+    CHECK( arena.stats().m_chunk_count == 3u );
+
+    SECTION( "keeping a chunk for reuse on reset" )
+    {
+        arena.reset();
+
+        const auto stats = arena.stats();
+        CHECK( stats.m_chunk_count == 1u );
+        CHECK( stats.m_bytes_reserved == 128u );
+        CHECK( stats.m_bytes_allocated == 0u );
+        CHECK( stats.m_allocation_count == 0u );
+
+        CHECK( arena.allocate(100u) != nullptr );
+        CHECK( arena.stats().m_chunk_count == 1u );
+    }
+
+    SECTION( "returning all chunks on release" )
+    {
+        arena.release();
+
+        CHECK( arena.stats().m_chunk_count == 0u );
+        CHECK( arena.stats().m_bytes_reserved == 0u );
+
+        CHECK( arena.allocate(100u) != nullptr );
+        CHECK( arena.stats().m_chunk_count == 1u );
+    }
+}
+
+
+TEST_CASE( "arena allocator works with buffers and streams", "[allocators][arena_allocator]" )
+{
+    arena_allocator arena{ 1024u };
+    std::array<uint8_t, 4u> junk = { 0x01, 0x02, 0x03, 0x04 };
+
+    {
+        owning_buffer buffer{ weak_buffer{ junk.data(), junk.size() }, &arena };
+        CHECK( buffer.allocator() == &arena );
+        CHECK( buffer[3] == 4 );
+
+        memory_output_stream stream{ &arena };
+        for (int i = 0; i < 100; i++)
+        {
+            stream.write_bytes(weak_buffer{ junk.data(), junk.size() });
+        }
+
+        CHECK( stream.length() == 400 );
+        CHECK( stream.view()[399] == 4 );
+    }
+
+    // the stream kept growing its block in place
+    CHECK( arena.stats().m_allocation_count == 2u );
+    CHECK( arena.stats().m_chunk_count == 1u );
+    CHECK_THROWS_AS( arena_allocator{ 0u }, io_exception );
+    CHECK_THROWS_AS( arena_allocator( 16u, nullptr ), io_exception );
+}
+
+
+///
+/// Allocator which checks that every deallocation gets the size of its allocation.
+///
+class size_tracking_allocator final
+    : public base_allocator
+{
+public:
+
+    std::size_t m_live_bytes = 0u;
+    std::size_t m_live_count = 0u;
+
+    byte* allocate(std::size_t size, std::size_t alignment = k_default_alignment) override
+    {
+        m_live_bytes += size;
+        m_live_count++;
+        return default_allocator::get_default()->allocate(size, alignment);
+    }
+
+    void deallocate(byte* ptr, std::size_t size, std::size_t alignment = k_default_alignment) override
+    {
+        m_live_bytes -= size;
+        m_live_count--;
+        default_allocator::get_default()->deallocate(ptr, size, alignment);
+    }
+};
+
+
+TEST_CASE( "allocators receive allocation sizes on deallocation", "[allocators]" )
+{
+    size_tracking_allocator tracker;
+    std::array<uint8_t, 4u> junk = { 0x01, 0x02, 0x03, 0x04 };
+
+    {
+        owning_buffer buffer{ 3u, &tracker };
+        CHECK( tracker.m_live_bytes == 3u );
+
+        for (int i = 0; i < 10; i++)
+        {
+            buffer.insert(junk.begin(), junk.end(), buffer.end());
+        }
+
+        CHECK( tracker.m_live_bytes == buffer.capacity() );
+        CHECK( tracker.m_live_count == 1u );
+
+        owning_buffer other{ weak_buffer{ junk.data(), junk.size() }, &tracker };
+        buffer = std::move(other);
+
+        CHECK( tracker.m_live_bytes == 4u );
+    }
+
+    CHECK( tracker.m_live_bytes == 0u );
+    CHECK( tracker.m_live_count == 0u );
+
+    {
+        arena_allocator arena{ 64u, &tracker };
+        arena.allocate(10u);
+        arena.allocate(100u);
+        arena.reset();
+        CHECK( tracker.m_live_count == 1u );
+    }
+
+    CHECK( tracker.m_live_bytes == 0u );
+    CHECK( tracker.m_live_count == 0u );
+}
+
+
+TEST_CASE( "pool allocator recycles blocks by size class", "[allocators][pool_allocator]" )
+{
+    size_tracking_allocator tracker;
+
+    {
+        pool_allocator pool{ 256u, 1024u, &tracker };
+
+        CHECK( pool.max_block_size() == 256u );
+        CHECK( pool_allocator::block_size_for(1u) == 16u );
+        CHECK( pool_allocator::block_size_for(17u) == 32u );
+        CHECK( pool_allocator::block_size_for(256u) == 256u );
+
+        SECTION( "with blocks reused after deallocation" )
+        {
+            const auto a = pool.allocate(20u);
+            const auto b = pool.allocate(30u);
+
+            CHECK( b - a == 32 );
+            CHECK( reinterpret_cast<std::uintptr_t>(a) % alignof(std::max_align_t) == 0u );
+            CHECK( pool.stats().m_blocks_in_use == 2u );
+            CHECK( pool.stats().m_slab_count == 1u );
+
+            pool.deallocate(a, 20u);
+            CHECK( pool.allocate(32u) == a );
+
+            // other classes take separate slabs
+            const auto c = pool.allocate(100u);
+            CHECK( c != a );
+            CHECK( pool.stats().m_slab_count == 2u );
+            CHECK( pool.stats().m_bytes_reserved == 2048u );
+        }
+
+        SECTION( "with new slabs when a class runs out" )
+        {
+            for (int i = 0; i < 5; i++)
+            {
+                std::memset(pool.allocate(256u), i, 256u);
+            }
+
+            CHECK( pool.stats().m_slab_count == 2u );
+            CHECK( pool.stats().m_blocks_in_use == 5u );
+        }
+
+        SECTION( "with resizing within a size class" )
+        {
+            const auto a = pool.allocate(20u);
+            std::memset(a, 0xAB, 20u);
+
+            CHECK( pool.try_expand(a, 20u, 32u) );
+            CHECK( !pool.try_expand(a, 32u, 33u) );
+
+            const auto moved = pool.reallocate(a, 32u, 100u, 20u);
+            CHECK( moved != a );
+            CHECK( moved[19] == 0xAB );
+            CHECK( pool.stats().m_blocks_in_use == 1u );
+
+            const auto big = pool.reallocate(moved, 100u, 1000u, 100u);
+            CHECK( big[19] == 0xAB );
+            CHECK( pool.stats().m_blocks_in_use == 0u );
+            CHECK( pool.stats().m_upstream_allocations == 1u );
+
+            pool.deallocate(pool.reallocate(big, 1000u, 2000u, 1000u), 2000u);
+            CHECK( pool.stats().m_upstream_allocations == 0u );
+        }
+
+        SECTION( "with big blocks passed upstream" )
+        {
+            const auto live = tracker.m_live_count;
+            const auto big = pool.allocate(1000u);
+
+            CHECK( tracker.m_live_count == live + 1u );
+            CHECK( pool.stats().m_upstream_allocations == 1u );
+
+            pool.deallocate(big, 1000u);
+            CHECK( tracker.m_live_count == live );
+            CHECK( pool.stats().m_upstream_allocations == 0u );
+        }
+
+        SECTION( "with buffers growing through size classes" )
+        {
+            std::array<uint8_t, 4u> junk = { 0x01, 0x02, 0x03, 0x04 };
+
+            {
+                owning_buffer buffer{ &pool };
+                for (int i = 0; i < 100; i++)
+                {
+                    buffer.insert(junk.begin(), junk.end(), buffer.end());
+                }
+
+                CHECK( buffer.length() == 400u );
+                CHECK( buffer[399] == 4 );
+            }
+
+            CHECK( pool.stats().m_blocks_in_use == 0u );
+            CHECK( pool.stats().m_upstream_allocations == 0u );
+        }
+    }
+
+    CHECK( tracker.m_live_bytes == 0u );
+    CHECK( tracker.m_live_count == 0u );
+
+    CHECK_THROWS_AS( pool_allocator( 256u, 16u ), io_exception );
+    CHECK_THROWS_AS( pool_allocator( 256u, 1024u, nullptr ), io_exception );
+}
+
+
+TEST_CASE( "aligned allocator returns aligned blocks", "[allocators][aligned_allocator]" )
+{
+    SECTION( "with the default block alignment" )
+    {
+        const auto alloc = aligned_allocator::get_default();
+        CHECK( alloc->alignment() == k_default_block_alignment );
+
+        owning_buffer buffer{ 10u, alloc };
+        CHECK( reinterpret_cast<std::uintptr_t>(buffer.data()) % 4096u == 0u );
+
+        // growth goes through allocate, so the block stays aligned
+        std::array<uint8_t, 4u> junk = { 0x01, 0x02, 0x03, 0x04 };
+        for (int i = 0; i < 1000; i++)
+        {
+            buffer.insert(junk.begin(), junk.end(), buffer.end());
+        }
+
+        CHECK( buffer.length() == 4000u );
+        CHECK( buffer[3996] == 0x01 );
+        CHECK( reinterpret_cast<std::uintptr_t>(buffer.data()) % 4096u == 0u );
+    }
+
+    SECTION( "with a custom alignment" )
+    {
+        aligned_allocator alloc{ 64u };
+        CHECK( alloc.alignment() == 64u );
+
+        const auto block = alloc.allocate(100u);
+        CHECK( reinterpret_cast<std::uintptr_t>(block) % 64u == 0u );
+        alloc.deallocate(block, 100u);
+
+        CHECK( aligned_allocator{ 1u }.alignment() == alignof(std::max_align_t) );
+    }
+
+    SECTION( "but not with alignments which aren't powers of two" )
+    {
+        CHECK_THROWS_AS( aligned_allocator{ 0u }, io_exception );
+        CHECK_THROWS_AS( aligned_allocator{ 48u }, io_exception );
+    }
+}
+
+
+TEST_CASE( "allocators return over-aligned blocks", "[allocators]" )
+{
+    size_tracking_allocator tracker;
+
+    SECTION( "from the default allocator" )
+    {
+        const auto alloc = default_allocator::get_default();
+
+        auto block = alloc->allocate(100u, 256u);
+        CHECK( reinterpret_cast<std::uintptr_t>(block) % 256u == 0u );
+        std::memset(block, 0xAB, 100u);
+
+        block = alloc->reallocate(block, 100u, 10000u, 100u, 256u);
+        CHECK( reinterpret_cast<std::uintptr_t>(block) % 256u == 0u );
+        CHECK( block[99] == 0xAB );
+
+        alloc->deallocate(block, 10000u, 256u);
+    }
+
+    SECTION( "from an arena, padding its cursor" )
+    {
+        arena_allocator arena{ 1024u, &tracker };
+
+        const auto a = arena.allocate(1u);
+        const auto b = arena.allocate(10u, 128u);
+        const auto c = arena.allocate(10u, 2048u);
+
+        CHECK( reinterpret_cast<std::uintptr_t>(b) % 128u == 0u );
+        CHECK( reinterpret_cast<std::uintptr_t>(c) % 2048u == 0u );
+        CHECK( b > a );
+        CHECK( arena.stats().m_bytes_allocated >= 21u );
+    }
+
+    SECTION( "from a pool, passing them upstream" )
+    {
+        pool_allocator pool{ 256u, 1024u, &tracker };
+
+        const auto block = pool.allocate(32u, 512u);
+        CHECK( reinterpret_cast<std::uintptr_t>(block) % 512u == 0u );
+        CHECK( pool.stats().m_upstream_allocations == 1u );
+        CHECK( pool.stats().m_blocks_in_use == 0u );
+
+        pool.deallocate(block, 32u, 512u);
+        CHECK( pool.stats().m_upstream_allocations == 0u );
+    }
+
+    CHECK( tracker.m_live_count == 0u );
+}
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "reio/byteswap.hpp"
+using namespace reio;
+
+
+///
+/// Run a test body once for every bulk byte-swapping kernel supported by the CPU,
+/// restoring the automatically selected one afterwards.
+///
+template<typename Func>
+static void for_each_bswap_kernel(Func&& func)
+{
+    const auto original = active_bswap_kernel();
+
+    for (const auto kernel : { bswap_kernel::scalar, bswap_kernel::ssse3, bswap_kernel::avx2, bswap_kernel::neon })
+    {
+        if (select_bswap_kernel(kernel))
+        {
+            func(kernel);
+        }
+    }
+
+    select_bswap_kernel(original);
+}
+
+
+TEST_CASE( "bulk bswap kernel selection", "[types][byteswap]" )
+{
+    CHECK( is_bswap_kernel_supported(bswap_kernel::scalar) );
+    CHECK( is_bswap_kernel_supported(active_bswap_kernel()) );
+
+    const auto original = active_bswap_kernel();
+
+    CHECK( select_bswap_kernel(bswap_kernel::scalar) );
+    CHECK( active_bswap_kernel() == bswap_kernel::scalar );
+    CHECK( select_bswap_kernel(original) );
+}
+
+
+TEMPLATE_TEST_CASE( "bulk bswap swaps whole ranges", "[types][byteswap]", uint16_t, uint32_t, uint64_t, float, double )
+{
+    // odd lengths to cover both vector loops and scalar tails
+    const auto count = GENERATE( 0u, 1u, 7u, 16u, 33u, 1021u );
+    const auto length = count * sizeof(TestType);
+
+    std::vector<byte> values(length);
+    std::ranges::generate(values, [n = 0u]() mutable { return static_cast<byte>(n++ * 37u + 11u); });
+
+    std::vector<TestType> expected(count);
+    std::memcpy(expected.data(), values.data(), length);
+    std::ranges::transform(expected, expected.begin(), [](TestType v) { return bswap(v); });
+
+    // sections aren't re-entered within a single run, so kernels are checked in a plain loop
+    for_each_bswap_kernel([&](bswap_kernel kernel) {
+        INFO( "kernel " << static_cast<int>(kernel) );
+
+        std::vector<TestType> in_place(count);
+        std::memcpy(in_place.data(), values.data(), length);
+
+        bswap_range(std::span<TestType>{ in_place });
+        CHECK( std::memcmp(in_place.data(), expected.data(), length) == 0 );
+
+        bswap_range<TestType>(weak_buffer{ reinterpret_cast<byte*>(in_place.data()), length });
+        CHECK( std::memcmp(in_place.data(), values.data(), length) == 0 );
+
+        std::vector<TestType> dest(count);
+        bswap_range(std::span<const TestType>{ expected }, std::span<TestType>{ dest });
+        CHECK( std::memcmp(dest.data(), values.data(), length) == 0 );
+
+        std::vector<TestType> dest_2(count);
+        bswap_range<TestType>(weak_buffer{ reinterpret_cast<byte*>(dest.data()), length },
+                              weak_buffer{ reinterpret_cast<byte*>(dest_2.data()), length });
+        CHECK( std::memcmp(dest_2.data(), expected.data(), length) == 0 );
+    });
+}
+
+
+TEST_CASE( "bulk bswap handles unaligned and invalid buffers", "[types][byteswap]" )
+{
+    std::array<byte, 19u> data{};
+    std::iota(data.begin(), data.end(), byte{ 0u });
+
+    SECTION( "at unaligned addresses" )
+    {
+        bswap_range<uint16_t>(weak_buffer{ data.data() + 1, 18u });
+        CHECK( data[0] == 0 );
+        CHECK( data[1] == 2 );
+        CHECK( data[2] == 1 );
+        CHECK( data[17] == 18 );
+        CHECK( data[18] == 17 );
+    }
+
+    SECTION( "of single bytes" )
+    {
+        std::array<byte, 19u> dest{};
+        bswap_range<uint8_t>(weak_buffer{ data.data(), data.size() }, weak_buffer{ dest.data(), dest.size() });
+        CHECK( dest == data );
+    }
+
+    SECTION( "with mismatching lengths" )
+    {
+        CHECK_THROWS_AS( bswap_range<uint32_t>(weak_buffer{ data.data(), 6u }), io_exception );
+        CHECK_THROWS_AS( bswap_range<uint32_t>(weak_buffer{ data.data(), 8u }, weak_buffer{ data.data(), 4u }), io_exception );
+        CHECK_THROWS_AS( bswap_bytes(3u, data.data(), data.data(), 1u), io_exception );
+    }
+}
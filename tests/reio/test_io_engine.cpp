@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+#include "reio/io_engine.hpp"
+using namespace reio;
+
+
+static constexpr auto k_engine_small_path = REIO_TESTS_DATA_DIR "/small.bin";
+
+
+TEST_CASE( "I/O engine can be initialized", "[io_engine]" )
+{
+    SECTION( "with the best available backend" )
+    {
+        io_engine engine{};
+
+        CHECK( engine.queue_depth() == k_default_io_queue_depth );
+        CHECK( engine.in_flight() == 0u );
+        CHECK( (engine.backend() == io_backend::uring) == io_engine::is_uring_supported() );
+    }
+
+    SECTION( "with a forced fallback" )
+    {
+        io_engine engine{ { .m_queue_depth = 4u, .m_force_fallback = true } };
+
+        CHECK( engine.backend() == io_backend::pread );
+        CHECK( engine.queue_depth() == 4u );
+    }
+
+    SECTION( "but not with an empty queue" )
+    {
+        CHECK_THROWS_AS( io_engine{ { .m_queue_depth = 0u } }, io_exception );
+    }
+}
+
+
+TEST_CASE( "I/O engine executes batches of requests", "[io_engine]" )
+{
+    const auto force_fallback = GENERATE( false, true );
+    io_engine engine{ { .m_queue_depth = 4u, .m_force_fallback = force_fallback } };
+
+    const int fd = ::open(k_engine_small_path, O_RDONLY | O_CLOEXEC);
+    REQUIRE( fd >= 0 );
+
+    std::vector<io_completion> completions;
+
+    SECTION( "of reads into own buffers" )
+    {
+        engine.submit_read(fd, 0, 4u, 10u);
+        engine.submit_read(fd, 4, 3u, 11u);
+        engine.submit_read(fd, 16, 8u, 12u);
+        CHECK( engine.in_flight() == 3u );
+
+        CHECK( engine.wait(completions, 3u) == 3u );
+        CHECK( engine.in_flight() == 0u );
+
+        std::ranges::sort(completions, {}, &io_completion::m_tag);
+
+        CHECK( completions[0].m_result == 4 );
+        CHECK( std::ranges::equal(completions[0].m_buffer, std::array<byte, 4u>{ 0x01, 0x02, 0x03, 0x04 }) );
+        CHECK( completions[1].m_result == 3 );
+        CHECK( std::ranges::equal(completions[1].m_buffer, std::array<byte, 3u>{ 0x0C, 0xA8, 0x61 }) );
+
+        // short reads are trimmed
+        CHECK( completions[2].m_result == 3 );
+        CHECK( completions[2].m_buffer.length() == 3u );
+    }
+
+    SECTION( "of reads into external buffers" )
+    {
+        std::array<byte, 19u> data{};
+
+        engine.submit_read(fd, 10, weak_buffer{ data.data() + 10u, 9u }, 1u);
+        engine.submit_read(fd, 0, weak_buffer{ data.data(), 10u }, 0u);
+        CHECK( engine.submit() == (engine.backend() == io_backend::uring ? 2u : 0u) );
+
+        CHECK( engine.wait(completions, 2u) == 2u );
+        CHECK( completions[0].m_buffer.length() == 0u );
+        CHECK( data[0] == 0x01 );
+        CHECK( data[18] == 0x01 );
+    }
+
+    SECTION( "larger than the queue depth" )
+    {
+        for (uint64_t i = 0u; i < 19u; i++)
+        {
+            engine.submit_read(fd, static_cast<int64_t>(i), 1u, i);
+            CHECK( engine.in_flight() <= i + 1u );
+        }
+
+        while (engine.in_flight() > 0u)
+        {
+            engine.wait(completions);
+        }
+
+        REQUIRE( completions.size() == 19u );
+        std::ranges::sort(completions, {}, &io_completion::m_tag);
+        CHECK( completions[4].m_buffer[0] == 0x0C );
+        CHECK( completions[18].m_buffer[0] == 0x01 );
+    }
+
+    SECTION( "with errors reported as negated errno" )
+    {
+        const auto path = (std::filesystem::temp_directory_path() / "reio_test_io_engine.bin").string();
+        const int out = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        REQUIRE( out >= 0 );
+
+        std::array<byte, 3u> junk = { 0x0A, 0x0B, 0x0C };
+
+        engine.submit_read(out, 0, 4u, 0u);
+        engine.submit_write(out, 2, owning_buffer{ weak_buffer{ junk.data(), junk.size() } }, 1u);
+        CHECK( engine.wait(completions, 2u) == 2u );
+
+        std::ranges::sort(completions, {}, &io_completion::m_tag);
+        CHECK( completions[0].m_result == -EBADF );
+        CHECK( completions[1].m_result == 3 );
+        CHECK( completions[1].m_buffer.length() == 3u );
+
+        ::close(out);
+        CHECK( std::filesystem::file_size(path) == 5u );
+        std::filesystem::remove(path);
+    }
+
+    CHECK_THROWS_AS( engine.submit_read(-1, 0, 4u, 0u), io_exception );
+    CHECK_THROWS_AS( engine.submit_read(fd, -1, 4u, 0u), io_exception );
+    CHECK_THROWS_AS( engine.submit_read(fd, 0, 0u, 0u), io_exception );
+
+    ::close(fd);
+}
@@ -0,0 +1,93 @@
+#include <cstring>
+
+#include "reio/vm_allocator.hpp"
+#include "reio/buffers/owning_buffer.hpp"
+#include "reio/streams/memory_streams.hpp"
+using namespace reio;
+
+
+TEST_CASE( "vm allocator maps blocks over the threshold", "[allocators][vm_allocator]" )
+{
+    vm_allocator alloc{ { .m_threshold = 64u * 1024u } };
+
+    CHECK( alloc.page_size() > 0u );
+    CHECK( !alloc.is_mapped(1000u) );
+    CHECK( alloc.is_mapped(64u * 1024u) );
+
+    SECTION( "with small blocks going to the fallback" )
+    {
+        const auto block = alloc.allocate(100u);
+        REQUIRE( block != nullptr );
+
+        std::memset(block, 0xAB, 100u);
+        alloc.deallocate(block, 100u);
+    }
+
+    SECTION( "with page-aligned mappings" )
+    {
+        const auto size = 100u * 1024u + 1u;
+        const auto block = alloc.allocate(size);
+        REQUIRE( block != nullptr );
+        CHECK( reinterpret_cast<std::uintptr_t>(block) % alloc.page_size() == 0u );
+
+        // the tail of the last page belongs to the block as well
+        const auto page_end = (size + alloc.page_size() - 1u) / alloc.page_size() * alloc.page_size();
+        CHECK( alloc.try_expand(block, size, page_end) );
+        CHECK( alloc.try_expand(block, page_end, 64u * 1024u) );
+
+        std::memset(block, 0xAB, 64u * 1024u);
+        alloc.deallocate(block, 64u * 1024u);
+    }
+
+    SECTION( "with contents kept on reallocation" )
+    {
+        auto block = alloc.allocate(1000u);
+        std::memset(block, 0x11, 1000u);
+
+        // crossing the threshold
+        block = alloc.reallocate(block, 1000u, 128u * 1024u, 1000u);
+        REQUIRE( block != nullptr );
+        CHECK( block[999] == 0x11 );
+
+        std::memset(block + 1000, 0x22, 128u * 1024u - 1000u);
+
+        // remapping
+        block = alloc.reallocate(block, 128u * 1024u, 8u * 1024u * 1024u, 128u * 1024u);
+        REQUIRE( block != nullptr );
+        CHECK( block[999] == 0x11 );
+        CHECK( block[128u * 1024u - 1u] == 0x22 );
+
+        block[8u * 1024u * 1024u - 1u] = 0x33;
+
+        // and back below it
+        block = alloc.reallocate(block, 8u * 1024u * 1024u, 2000u, 2000u);
+        REQUIRE( block != nullptr );
+        CHECK( block[999] == 0x11 );
+        CHECK( block[1999] == 0x22 );
+
+        alloc.deallocate(block, 2000u);
+    }
+
+    CHECK_THROWS_AS( vm_allocator( { .m_threshold = 0u } ), io_exception );
+    CHECK_THROWS_AS( vm_allocator( {}, nullptr ), io_exception );
+}
+
+
+TEST_CASE( "vm allocator backs huge memory streams", "[allocators][vm_allocator]" )
+{
+    vm_allocator alloc{ { .m_threshold = 256u * 1024u, .m_huge_pages = true } };
+    memory_output_stream stream{ &alloc };
+
+    std::array<byte, 4096u> block{};
+    for (int i = 0; i < 1024; i++)
+    {
+        std::memset(block.data(), i & 0xFF, block.size());
+        stream.write_bytes(weak_buffer{ block.data(), block.size() });
+    }
+
+    CHECK( stream.length() == 4 * 1024 * 1024 );
+    CHECK( stream.capacity() >= stream.length() );
+    CHECK( stream.view()[0] == 0 );
+    CHECK( stream.view()[4096u * 300u + 5u] == 300 % 256 );
+    CHECK( stream.view()[4u * 1024u * 1024u - 1u] == 1023 % 256 );
+}